@@ -36,7 +36,9 @@
   by libxslt. This include:
     * Using exsl:document instead of xsl:result-document
     * Using func:function instead of xsl:function
-    * Using set:distinct instead of xsl:distinct
+  The methods of a class are grouped by name in overload sets and the output
+  paths are precomputed by muddoc, so that a class with many methods is
+  processed in linear time.
  -->
 <xsl:stylesheet
     version="1.0"
@@ -44,8 +46,7 @@
     xmlns:xsl="http://www.w3.org/1999/XSL/Transform"
     xmlns:exsl="http://exslt.org/common"
     xmlns:func="http://exslt.org/functions"
-    xmlns:set="http://exslt.org/sets"
-    extension-element-prefixes="exsl func set"
+    extension-element-prefixes="exsl func"
     exclude-result-prefixes="xs">
 
   <xsl:output method="html" indent="yes" omit-xml-declaration="yes"/>
@@ -56,6 +57,9 @@
   <!-- Specify the base URL. typically a "http://" or "file://" URI -->
   <xsl:param name="base-href">file:///tmp/</xsl:param>
 
+  <!-- The documented symbols by their USR, to resolve the references -->
+  <xsl:key name="symbol" match="class|method" use="usr"/>
+
   <!--
     Return the output-folder a '/' separated relative path folder for the
     current element. Each folder element is either a class or namespace
@@ -106,7 +110,7 @@
           <h1><xsl:value-of select="@file"/></h1>
           <h2>Classes</h2>
           <table>
-            <xsl:apply-templates select ="//class[count(*)&gt;0]"/>
+            <xsl:apply-templates select ="//class[*]"/>
           </table>
         </body>
       </html>
@@ -117,7 +121,7 @@
   <xsl:template match="class">
     <!-- Define the file to output the class definition to -->
     <xsl:variable name="output-file">
-      <xsl:value-of select="concat($base-dir, concat(func:output-folder(), '_$index$_.html'))"/>
+      <xsl:value-of select="concat($base-dir, concat(@path, '_$index$_.html'))"/>
     </xsl:variable>
     <xsl:message>Generating <xsl:value-of select="$output-file"/></xsl:message>
 
@@ -145,7 +149,7 @@
         <body>
           <h1>
             <span style="font-size:0.66em">
-              <xsl:value-of select="func:namespace()"/>
+              <xsl:value-of select="@namespace"/>
             </span>
             <xsl:value-of select="@name"/>
           </h1>
@@ -165,20 +169,16 @@
             </xsl:when>
           </xsl:choose>
           <xsl:choose>
-            <xsl:when test="method/info[@constructor] | method/info[@destructor]">
+            <xsl:when test="overload-set[@kind='constructor' or @kind='destructor']">
               <h2>Construction and Destruction Member Functions</h2>
               <table>
-                <xsl:for-each select="set:distinct(method/info[@constructor]/../@name)">
+                <xsl:for-each select="overload-set[@kind='constructor']">
                   <xsl:call-template name="method-group">
-                    <xsl:with-param name="name" select="."/>
-                    <xsl:with-param name="class" select="../.."/>
                     <xsl:with-param name="brief">Constructors</xsl:with-param>
                   </xsl:call-template>
                 </xsl:for-each>
-                <xsl:for-each select="set:distinct(method/info[@destructor]/../@name)">
+                <xsl:for-each select="overload-set[@kind='destructor']">
                   <xsl:call-template name="method-group">
-                    <xsl:with-param name="name" select="."/>
-                    <xsl:with-param name="class" select="../.."/>
                     <xsl:with-param name="brief">Destructor</xsl:with-param>
                   </xsl:call-template>
                 </xsl:for-each>
@@ -186,15 +186,12 @@
             </xsl:when>
           </xsl:choose>
           <xsl:choose>
-            <xsl:when test="method/info[not(@constructor) and not(@destructor)]">
+            <xsl:when test="overload-set[@kind='method']">
               <h2>Member Functions</h2>
-              <xsl:value-of select="method/info[not(@constructor) and not(@destructor)]"/>
+              <xsl:value-of select="overload-set[@kind='method']/method/info"/>
               <table>
-                <xsl:for-each select="set:distinct(method/info[not(@constructor) and not(@destructor)]/../@name)">
-                  <xsl:call-template name="method-group">
-                    <xsl:with-param name="name" select="."/>
-                    <xsl:with-param name="class" select="../.."/>
-                  </xsl:call-template>
+                <xsl:for-each select="overload-set[@kind='method']">
+                  <xsl:call-template name="method-group"/>
                 </xsl:for-each>
               </table>
             </xsl:when>
@@ -264,17 +261,17 @@
   </xsl:template>
 
   <!--
-    Group methods with the same name as part of an encompassing table.
+    Group methods with the same name as part of an encompassing table. The
+    current node is the overload set of the methods.
     -->
   <xsl:template name="method-group">
-    <xsl:param name="name"/>
-    <xsl:param name="class"/>
     <xsl:param name="brief">
-      <xsl:apply-templates select="($class/method[@name=$name])[1]/brief"/>
+      <xsl:apply-templates select="method[1]/brief"/>
     </xsl:param>
+    <xsl:variable name="name" select="@name"/>
     <!-- The file for the method group -->
     <xsl:variable name="output-file">
-      <xsl:value-of select="concat(concat($base-dir, concat(func:output-folder(), $name)), '.html')"/>
+      <xsl:value-of select="concat(concat($base-dir, @path), '.html')"/>
     </xsl:variable>
     <!-- The group method entry in the class table -->
     <tr>
@@ -301,7 +298,7 @@
         <body>
           <h1>
             <span style="font-size:0.66em">
-              <xsl:value-of select="func:namespace()"/>
+              <xsl:value-of select="@namespace"/>
             </span>
             <xsl:value-of select="$name"/>
           </h1>
@@ -312,10 +309,10 @@
           </div>
           <h2>Summary</h2>
           <table>
-            <xsl:apply-templates select ="$class/method[@name=$name]" mode="brief-table"/>
+            <xsl:apply-templates select ="method" mode="brief-table"/>
           </table>
           <h2>Detailed</h2>
-          <xsl:apply-templates select ="$class/method[@name=$name]"/>
+          <xsl:apply-templates select ="method"/>
         </body>
       </html>
     </exsl:document>
@@ -325,6 +322,60 @@
     Comment text
     -->
   <xsl:template match="brief|detailed">
+    <xsl:apply-templates select="node()" mode="text"/>
+  </xsl:template>
+
+  <xsl:template match="text()" mode="text">
+    <xsl:value-of select="."/>
+  </xsl:template>
+
+  <xsl:template match="code" mode="text">
+    <code><xsl:value-of select="."/></code>
+  </xsl:template>
+
+  <xsl:template match="bold" mode="text">
+    <b><xsl:value-of select="."/></b>
+  </xsl:template>
+
+  <xsl:template match="emphasis" mode="text">
+    <em><xsl:value-of select="."/></em>
+  </xsl:template>
+
+  <xsl:template match="verbatim" mode="text">
+    <pre><xsl:value-of select="."/></pre>
+  </xsl:template>
+
+  <xsl:template match="see" mode="text">
+    <div class="see">
+      <xsl:text>See also: </xsl:text>
+      <xsl:apply-templates select="node()" mode="text"/>
+    </div>
+  </xsl:template>
+
+  <!--
+    A reference links to the page of a class or method. A reference that
+    could not be resolved, or to a symbol without a page, is plain text.
+    -->
+  <xsl:template match="ref" mode="text">
+    <xsl:variable name="target" select="key('symbol', @usr)[1]"/>
+    <xsl:choose>
+      <xsl:when test="$target/self::class">
+        <a href="{concat($base-href, $target/@path, '_$index$_.html')}">
+          <code><xsl:value-of select="."/></code>
+        </a>
+      </xsl:when>
+      <xsl:when test="$target/self::method">
+        <a href="{concat($base-href, $target/@path, '.html')}">
+          <code><xsl:value-of select="."/></code>
+        </a>
+      </xsl:when>
+      <xsl:otherwise>
+        <code><xsl:value-of select="."/></code>
+      </xsl:otherwise>
+    </xsl:choose>
+  </xsl:template>
+
+  <xsl:template match="*" mode="text">
     <xsl:value-of select="."/>
   </xsl:template>
 
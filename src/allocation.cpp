@@ -0,0 +1,117 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#include <cstdlib>
+#include <new>
+#include <malloc.h>
+#include "stats.h"
+
+/*
+ * Replacement of the global allocation functions, such that the allocations
+ * can be counted per phase and per kind of descriptor. These are part of the
+ * executable only, but they replace the operators of the clang library as
+ * well, so its allocations are counted against the phase of the thread that
+ * makes them, like parsing. The counting itself is only performed once it
+ * has been enabled with muddoc::Stats::memory().
+ */
+
+namespace {
+
+void*
+allocate(size_t size)
+{
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr != nullptr) {
+        muddoc::Stats::allocated(::malloc_usable_size(ptr));
+    }
+    return ptr;
+}
+
+} // namespace
+
+void*
+operator new(size_t size)
+{
+    void* ptr = allocate(size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void*
+operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void*
+operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size);
+}
+
+void*
+operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size);
+}
+
+void
+operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void
+operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void
+operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void
+operator delete[](void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void
+operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
+
+void
+operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
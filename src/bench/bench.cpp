@@ -0,0 +1,476 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <clang-c/Index.h>
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/DeclTemplate.h>
+#include "descriptor.h"
+#include "sink.h"
+#include "symbols.h"
+#include "utility.h"
+#include "visitor.h"
+#include "warn_error.h"
+
+/*
+ * Micro-benchmarks of the hot functions of muddoc: the XML escaping, the
+ * rendering of comments, the output of descriptors and the file filter.
+ *
+ * The declarations are parsed from generated in-memory headers, such that
+ * the inputs are the same on every machine. Each benchmark is run in batches
+ * that take at least 10 ms, and the median of the batches is reported in
+ * JSON as the time per operation and the bytes processed per second.
+ */
+
+namespace {
+
+/* The name of the documented header and of a header it includes */
+const char* main_header = "bench.h";
+const char* other_header = "other.h";
+
+/* The outcome of a single benchmark */
+struct Result
+{
+    std::string name;
+    uint64_t iterations;
+    double ns_per_op;
+    double bytes_per_second;
+};
+
+/* The options of the benchmark run */
+struct Options
+{
+    const char* filter = nullptr;
+    const char* output = nullptr;
+    unsigned repetitions = 5;
+};
+
+/* A value the compiler cannot prove to be unused */
+volatile size_t sink = 0;
+
+/* The time of a batch of iterations in nanoseconds */
+uint64_t
+batch(const std::function<void()>& function, uint64_t iterations)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < iterations; ++i) {
+        function();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            stop - start).count();
+}
+
+/* Run a benchmark that processes a number of bytes per operation */
+void
+measure(std::vector<Result>& results, const Options& options,
+        const char* name, uint64_t bytes, const std::function<void()>& function)
+{
+    if (options.filter != nullptr && ::strstr(name, options.filter) == nullptr) {
+        return;
+    }
+
+    // Find the number of iterations that takes at least 10 ms.
+    const uint64_t minimum = 10000000;
+    uint64_t iterations = 1;
+    while (batch(function, iterations) < minimum) {
+        iterations *= 2;
+    }
+
+    // Take the median of the batches to discard outliers.
+    std::vector<double> times;
+    for (unsigned i = 0; i < options.repetitions; ++i) {
+        times.push_back(double(batch(function, iterations)) / iterations);
+    }
+    std::sort(times.begin(), times.end());
+    double ns = times[times.size() / 2];
+    results.push_back({name, iterations, ns, ns > 0 ? bytes * 1e9 / ns : 0});
+    std::cerr << name << ": " << ns << " ns/op" << std::endl;
+}
+
+/* A paragraph of representative comment text */
+std::string
+paragraph(unsigned lines)
+{
+    std::stringstream sstr;
+    for (unsigned i = 0; i < lines; ++i) {
+        sstr << " * The value is compared with a <threshold> & the result is "
+                "\"clamped\" to the range of the @c type, line " << i << ".\n";
+    }
+    return sstr.str();
+}
+
+/* The header that is included by the documented header */
+std::string
+other()
+{
+    std::stringstream sstr;
+    for (unsigned i = 0; i < 64; ++i) {
+        sstr << "/** @brief Included class " << i << ". */\n"
+             << "class Included" << i << " { public: void method(); };\n";
+    }
+    return sstr.str();
+}
+
+/* The documented header */
+std::string
+header()
+{
+    std::stringstream sstr;
+    sstr << "#include \"" << other_header << "\"\n\n";
+
+    // A method with long comment paragraphs.
+    sstr << "/** @brief A class with long paragraphs. */\n"
+         << "class Paragraphs\n{\npublic:\n"
+         << "/**\n * @brief A method with long paragraphs.\n *\n * @details\n";
+    for (unsigned i = 0; i < 8; ++i) {
+        sstr << paragraph(12) << " *\n";
+    }
+    sstr << " */\nvoid paragraphs();\n};\n\n";
+
+    // A method with verbatim blocks.
+    sstr << "/** @brief A class with verbatim blocks. */\n"
+         << "class Verbatim\n{\npublic:\n"
+         << "/**\n * @brief A method with verbatim blocks.\n *\n";
+    for (unsigned i = 0; i < 4; ++i) {
+        sstr << " * @code\n";
+        for (unsigned j = 0; j < 16; ++j) {
+            sstr << " * if (a < b && c > d) { s = \"<\" + std::to_string("
+                 << j << "); }\n";
+        }
+        sstr << " * @endcode\n *\n";
+    }
+    sstr << " */\nvoid verbatim();\n};\n\n";
+
+    // A method with many parameters.
+    const unsigned params = 16;
+    sstr << "/** @brief A class with many parameters. */\n"
+         << "class Parameters\n{\npublic:\n"
+         << "/**\n * @brief A method with many parameters.\n *\n";
+    for (unsigned i = 0; i < params; ++i) {
+        sstr << " * @param p" << i << " The parameter " << i << ".\n";
+    }
+    sstr << " * @return The result.\n */\nconst char* parameters(";
+    for (unsigned i = 0; i < params; ++i) {
+        sstr << (i > 0 ? ", " : "") << (i % 2 ? "const char* p" : "double p")
+             << i;
+    }
+    sstr << ");\n};\n\n";
+
+    // Deeply nested namespaces, each with a documented class.
+    const unsigned depth = 32;
+    for (unsigned i = 0; i < depth; ++i) {
+        sstr << "/** @brief Namespace level " << i << ". */\n"
+             << "namespace n" << i << " {\n"
+             << "/** @brief Class at level " << i << ". */\n"
+             << "class Level" << i << " {\npublic:\n"
+             << "/** @brief Get the level.\n * @return The level. */\n"
+             << "int level() const;\n};\n";
+    }
+    for (unsigned i = 0; i < depth; ++i) {
+        sstr << "}\n";
+    }
+    return sstr.str();
+}
+
+/* Collect all the cursors of the translation unit */
+CXChildVisitResult
+collect(CXCursor cursor, CXCursor parent, CXClientData data)
+{
+    static_cast<std::vector<CXCursor>*>(data)->push_back(cursor);
+    return CXChildVisit_Recurse;
+}
+
+/* Find the first cursor of a kind and name */
+const CXCursor*
+find(const std::vector<CXCursor>& cursors, CXCursorKind kind,
+        const char* name)
+{
+    for (const auto& cursor: cursors) {
+        if (clang_getCursorKind(cursor) == kind &&
+            muddoc::str(clang_getCursorSpelling(cursor)) == name)
+        {
+            return &cursor;
+        }
+    }
+    std::cerr << "Unable to find '" << name << "' in the benchmark header"
+              << std::endl;
+    return nullptr;
+}
+
+/* The size of the raw comment of a cursor */
+uint64_t
+comment(const CXCursor& cursor)
+{
+    return muddoc::str(clang_Cursor_getRawCommentText(cursor)).size();
+}
+
+/* Write the results in JSON */
+void
+write(std::ostream& ostr, const std::vector<Result>& results)
+{
+    ostr << "{\"benchmarks\":[";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& result = results[i];
+        ostr << (i > 0 ? "," : "") << "\n{\"name\":"
+             << muddoc::quote(result.name)
+             << ",\"iterations\":" << result.iterations
+             << ",\"ns_per_op\":" << result.ns_per_op
+             << ",\"bytes_per_second\":" << result.bytes_per_second << "}";
+    }
+    ostr << "\n]}" << std::endl;
+}
+
+void
+help(const char* msg = nullptr)
+{
+    static const char* usage =
+R"(Usage: muddoc-bench [OPTIONS]
+
+Run the micro-benchmarks of muddoc and output the results in JSON.
+
+OPTIONS:
+    --help, -h          Show this help.
+    --filter TEXT       Only run the benchmarks whose name contains TEXT.
+    --output, -o FILE   Write the results to FILE instead of the standard
+                        output.
+    --repetitions N     Take the median of N batches. Defaults to 5.
+)";
+    if (msg != nullptr) {
+        std::cerr << msg << std::endl;
+        std::cerr << usage;
+        ::exit(1);
+    }
+    std::cout << usage;
+}
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+    Options options;
+    while (--argc && (*++argv)[0] == '-') {
+        if (::strcmp(*argv, "--help") == 0 || ::strcmp(*argv, "-h") == 0) {
+            help();
+            return 0;
+        }
+        else
+        if (::strcmp(*argv, "--filter") == 0) {
+            if (argc <= 1) {
+                help("Option --filter requires an argument.");
+            }
+            --argc, ++argv;
+            options.filter = *argv;
+        }
+        else
+        if (::strcmp(*argv, "--output") == 0 || ::strcmp(*argv, "-o") == 0) {
+            if (argc <= 1) {
+                help("Option --output,-o requires an argument.");
+            }
+            --argc, ++argv;
+            options.output = *argv;
+        }
+        else
+        if (::strcmp(*argv, "--repetitions") == 0) {
+            if (argc <= 1) {
+                help("Option --repetitions requires an argument.");
+            }
+            --argc, ++argv;
+            options.repetitions = static_cast<unsigned>(::atoi(*argv));
+            if (options.repetitions == 0) {
+                help("Option --repetitions requires a positive number.");
+            }
+        }
+        else {
+            std::stringstream sstr;
+            sstr << "Unknown option '" << *argv << "'";
+            help(sstr.str().c_str());
+        }
+    }
+
+    // The warnings are irrelevant and would only accumulate.
+    muddoc::diagnostics().threshold(muddoc::Diagnostics::Error);
+
+    // Parse the generated headers.
+    std::string main_text = header();
+    std::string other_text = other();
+    CXUnsavedFile files[] = {
+        { main_header, main_text.c_str(), main_text.size() },
+        { other_header, other_text.c_str(), other_text.size() }
+    };
+    const char* args[] = { "-x", "c++", "-fsyntax-only", "-std=c++17" };
+    CXIndex index = clang_createIndex(0, 0);
+    CXTranslationUnit unit = clang_parseTranslationUnit(
+            index, main_header, args, sizeof(args) / sizeof(args[0]),
+            files, sizeof(files) / sizeof(files[0]),
+            CXTranslationUnit_DetailedPreprocessingRecord);
+    if (unit == nullptr) {
+        std::cerr << "Unable to parse the benchmark header" << std::endl;
+        return 1;
+    }
+    std::vector<CXCursor> cursors;
+    clang_visitChildren(clang_getTranslationUnitCursor(unit), collect,
+            &cursors);
+    const CXCursor* paragraphs = find(cursors, CXCursor_CXXMethod,
+            "paragraphs");
+    const CXCursor* verbatim = find(cursors, CXCursor_CXXMethod, "verbatim");
+    const CXCursor* parameters = find(cursors, CXCursor_CXXMethod,
+            "parameters");
+    const CXCursor* outer = find(cursors, CXCursor_Namespace, "n0");
+    const CXCursor* record = find(cursors, CXCursor_ClassDecl, "Paragraphs");
+    if (paragraphs == nullptr || verbatim == nullptr ||
+        parameters == nullptr || outer == nullptr || record == nullptr)
+    {
+        return 1;
+    }
+    auto method = [](const CXCursor* cursor) {
+        return static_cast<const clang::CXXMethodDecl*>(cursor->data[0]);
+    };
+    muddoc::Visitor visitor(unit);
+    std::vector<Result> results;
+
+    // Escaping of plain text and of text with many special characters.
+    std::string plain(4096, 'x');
+    std::string markup;
+    while (markup.size() < 4096) {
+        markup += "if (a < b && c > d) { s = \"'\"; } ";
+    }
+    measure(results, options, "escape/plain", plain.size(), [&]() {
+        sink = sink + muddoc::escape(plain).size();
+    });
+    measure(results, options, "escape/markup", markup.size(), [&]() {
+        sink = sink + muddoc::escape(markup).size();
+    });
+
+    // Rendering of the comments, including creating the descriptor.
+    measure(results, options, "traverse/paragraphs", comment(*paragraphs),
+            [&]() {
+        muddoc::MethodDescriptor descriptor(*paragraphs, method(paragraphs));
+        descriptor.Descriptor::traverse();
+        sink = sink + descriptor.detailed().size();
+    });
+    measure(results, options, "traverse/verbatim", comment(*verbatim),
+            [&]() {
+        muddoc::MethodDescriptor descriptor(*verbatim, method(verbatim));
+        descriptor.Descriptor::traverse();
+        sink = sink + descriptor.detailed().size();
+    });
+    measure(results, options, "traverse/parameters", comment(*parameters),
+            [&]() {
+        muddoc::MethodDescriptor descriptor(*parameters, method(parameters));
+        descriptor.Descriptor::traverse();
+        sink = sink + descriptor.detailed().size();
+    });
+
+    // Output of descriptors that have been generated once, by the XML sink
+    // in a document of their own.
+    std::stringstream ostr;
+    muddoc::SymbolIndex symbols;
+    auto output = [&](const auto& descriptor, const char* name) {
+        auto emit = [&]() {
+            ostr.str("");
+            muddoc::XmlSink xml(ostr);
+            xml.begin(main_header, symbols);
+            xml.method(descriptor);
+            xml.end(main_header, 0);
+        };
+        emit();
+        uint64_t bytes = ostr.str().size();
+        measure(results, options, name, bytes, [&]() {
+            emit();
+            sink = sink + static_cast<size_t>(ostr.tellp());
+        });
+    };
+    muddoc::MethodDescriptor described(*parameters, method(parameters));
+    described.generate();
+    output(described, "output/method-parameters");
+
+    // A scope is output by the XML sink once its members have been output,
+    // so only the element of the scope itself is measured.
+    auto scope = [&](const auto& descriptor, const char* name) {
+        auto emit = [&]() {
+            ostr.str("");
+            muddoc::XmlSink xml(ostr);
+            xml.begin(main_header, symbols);
+            xml.begin(descriptor);
+            xml.end(descriptor);
+            xml.end(main_header, 0);
+        };
+        emit();
+        uint64_t bytes = ostr.str().size();
+        measure(results, options, name, bytes, [&]() {
+            emit();
+            sink = sink + static_cast<size_t>(ostr.tellp());
+        });
+    };
+    muddoc::ClassDescriptor klass(*record,
+            static_cast<const clang::CXXRecordDecl*>(record->data[0]),
+            visitor);
+    klass.generate();
+    scope(klass, "output/class-paragraphs");
+    muddoc::NamespaceDescriptor nested(*outer,
+            static_cast<const clang::NamespaceDecl*>(outer->data[0]),
+            visitor);
+    nested.generate();
+    scope(nested, "output/nested-namespaces");
+
+    // Filtering of all the cursors, of the documented and included header.
+    std::filesystem::path path(main_header);
+    muddoc::FileFilter filter(path);
+    size_t next = 0;
+    measure(results, options, "match/file", 0, [&]() {
+        sink = sink + filter.match(cursors[next]);
+        next = (next + 1) % cursors.size();
+    });
+
+    clang_disposeTranslationUnit(unit);
+    clang_disposeIndex(index);
+
+    // Output the results.
+    if (options.output != nullptr) {
+        std::ofstream file(options.output);
+        if (!file) {
+            std::cerr << "Error opening output file " << options.output
+                      << std::endl;
+            return 1;
+        }
+        write(file, results);
+    }
+    else {
+        write(std::cout, results);
+    }
+    return 0;
+}
@@ -0,0 +1,538 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "process.h"
+#include "results.h"
+
+/*
+ * Benchmark of muddoc over a fixed corpus of real headers that are
+ * available offline: a set of libstdc++ headers, the clang and LLVM headers
+ * that muddoc is built against, and the headers of muddoc itself.
+ *
+ * Each file is documented by a separate muddoc process with pinned flags.
+ * The parse time, traversal time, output size, number of warnings,
+ * end-to-end time and peak memory of each file are written as JSON, one file
+ * per line. A previous result can be used
+ * as a baseline, in which case any metric that regressed beyond a threshold
+ * is reported and the benchmark fails.
+ */
+
+namespace {
+
+using muddoc::number;
+using muddoc::slurp;
+
+/* The libstdc++ headers of the corpus */
+const char* libstdcxx_files[] = {
+    "algorithm", "functional", "map", "memory", "string", "unordered_map",
+    "vector"
+};
+
+/* The clang and LLVM headers of the corpus */
+const char* llvm_files[] = {
+    "clang-c/Index.h", "clang/AST/Comment.h", "clang/AST/Decl.h",
+    "clang/AST/DeclCXX.h", "llvm/ADT/SmallVector.h", "llvm/ADT/StringRef.h",
+    "llvm/Support/raw_ostream.h"
+};
+
+/* A file of the corpus */
+struct Entry
+{
+    std::string name;                   /* The name in the results */
+    std::filesystem::path base;         /* The folder that contains it */
+    std::string file;                   /* The file relative to the base */
+};
+
+/* The metrics of a file */
+struct Metrics
+{
+    double parse = 0;           /* The parse time in seconds */
+    double traverse = 0;        /* The traversal time in seconds */
+    uint64_t bytes = 0;         /* The size of the output */
+    uint64_t warnings = 0;      /* The number of warnings */
+    double seconds = 0;         /* The end-to-end time in seconds */
+    uint64_t peak = 0;          /* The peak memory in bytes */
+};
+
+/* The options of the benchmark run */
+struct Options
+{
+    std::filesystem::path muddoc = "./muddoc";
+    std::filesystem::path src;
+    std::filesystem::path llvm;
+    std::filesystem::path libstdcxx;
+    std::filesystem::path folder;
+    const char* output = nullptr;
+    const char* baseline = nullptr;
+    double threshold = 10;
+    unsigned repetitions = 3;
+};
+
+/* The flags that are passed to muddoc for every file */
+std::vector<std::string>
+flags(const Options& options)
+{
+    std::vector<std::string> flags = {
+        "-std=c++17", "--warning-level", "warning"
+    };
+    if (!options.llvm.empty()) {
+        flags.push_back("-I" + options.llvm.string());
+    }
+    return flags;
+}
+
+/* Find the most recent libstdc++ headers */
+std::filesystem::path
+libstdcxx()
+{
+    std::filesystem::path latest;
+    std::filesystem::path folder = "/usr/include/c++";
+    std::error_code error;
+    for (const auto& entry:
+         std::filesystem::directory_iterator(folder, error))
+    {
+        // Compare the versions numerically, such that 12 follows 9.
+        std::string name = entry.path().filename();
+        if (latest.empty() ||
+            ::atoi(name.c_str()) > ::atoi(latest.filename().c_str()))
+        {
+            latest = entry.path();
+        }
+    }
+    return latest;
+}
+
+/* The files of the corpus */
+std::vector<Entry>
+corpus(const Options& options)
+{
+    std::vector<Entry> entries;
+    if (!options.libstdcxx.empty()) {
+        for (const char* file: libstdcxx_files) {
+            entries.push_back({ std::string("libstdc++/") + file,
+                                options.libstdcxx, file });
+        }
+    }
+    if (!options.llvm.empty()) {
+        for (const char* file: llvm_files) {
+            entries.push_back({ std::string("llvm/") + file, options.llvm,
+                                file });
+        }
+    }
+    if (!options.src.empty()) {
+        std::vector<std::string> files;
+        for (const auto& entry:
+             std::filesystem::directory_iterator(options.src))
+        {
+            if (entry.path().extension() == ".h") {
+                files.push_back(entry.path().filename());
+            }
+        }
+        std::sort(files.begin(), files.end());
+        for (const auto& file: files) {
+            entries.push_back({ "muddoc/" + file, options.src, file });
+        }
+    }
+    return entries;
+}
+
+/* Get the wall clock time of a phase from the statistics in seconds */
+double
+phase(const std::string& stats, const char* name)
+{
+    size_t pos = stats.find(std::string("\"") + name + "\":{");
+    if (pos == std::string::npos) {
+        return 0;
+    }
+    return number(stats, "wall", pos) / 1e9;
+}
+
+/* Count the occurrences of a text */
+uint64_t
+occurrences(const std::string& text, const std::string& what)
+{
+    uint64_t count = 0;
+    for (size_t pos = text.find(what); pos != std::string::npos;
+         pos = text.find(what, pos + what.size()))
+    {
+        ++count;
+    }
+    return count;
+}
+
+/* Document a file once and collect its metrics */
+bool
+run(const Options& options, const Entry& entry, Metrics& metrics)
+{
+    std::filesystem::path output = options.folder / "output.xml";
+    std::filesystem::path stats = options.folder / "stats.json";
+    std::filesystem::path warnings = options.folder / "warnings.json";
+    std::vector<std::string> args = {
+        options.muddoc, "-b", entry.base, "-o", output,
+        "--stats-json", stats, "--warning-format", "json",
+        "--warning-file", warnings
+    };
+    std::vector<std::string> pinned = flags(options);
+    args.insert(args.end(), pinned.begin(), pinned.end());
+    args.push_back(entry.file);
+
+    muddoc::Usage usage;
+    if (!muddoc::execute(args, usage)) {
+        std::cerr << "Unable to document " << entry.name << std::endl;
+        return false;
+    }
+
+    // The traversal is everything but parsing and writing the output.
+    std::string text = slurp(stats);
+    metrics.parse = phase(text, "parse");
+    for (const char* name: { "other", "comments", "render", "pretty", "usr",
+                             "escape", "serialize" })
+    {
+        metrics.traverse += phase(text, name);
+    }
+    metrics.bytes = std::filesystem::file_size(output);
+    metrics.warnings = occurrences(slurp(warnings), "{\"severity\":");
+    metrics.seconds = usage.seconds;
+    metrics.peak = usage.peak;
+    return true;
+}
+
+/* The median of a time of a number of runs */
+double
+median(const std::vector<Metrics>& runs, double Metrics::* time)
+{
+    std::vector<double> times;
+    for (const auto& result: runs) {
+        times.push_back(result.*time);
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+/* Document a file a number of times and take the median times */
+bool
+measure(const Options& options, const Entry& entry, Metrics& metrics)
+{
+    std::vector<Metrics> runs(options.repetitions);
+    for (auto& result: runs) {
+        if (!run(options, entry, result)) {
+            return false;
+        }
+    }
+    metrics = runs.back();
+    metrics.parse = median(runs, &Metrics::parse);
+    metrics.traverse = median(runs, &Metrics::traverse);
+    metrics.seconds = median(runs, &Metrics::seconds);
+    for (const auto& result: runs) {
+        metrics.peak = std::max(metrics.peak, result.peak);
+    }
+    std::cerr << entry.name << ": parse " << metrics.parse << " s, traverse "
+              << metrics.traverse << " s" << std::endl;
+    return true;
+}
+
+/* Write the results, with one file per line */
+void
+write(std::ostream& ostr, const Options& options,
+        const std::vector<Entry>& entries,
+        const std::vector<Metrics>& results)
+{
+    std::string pinned;
+    for (const auto& flag: flags(options)) {
+        pinned += (pinned.empty() ? "" : " ") + flag;
+    }
+    ostr << "{\"flags\":\"" << pinned << "\",\"files\":[";
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const Metrics& metrics = results[i];
+        ostr << (i > 0 ? "," : "") << "\n{\"file\":\"" << entries[i].name
+             << "\",\"parse\":" << metrics.parse
+             << ",\"traverse\":" << metrics.traverse
+             << ",\"bytes\":" << metrics.bytes
+             << ",\"warnings\":" << metrics.warnings
+             << ",\"seconds\":" << metrics.seconds
+             << ",\"peak\":" << metrics.peak << "}";
+    }
+    ostr << "\n]}" << std::endl;
+}
+
+/* Read the results that have been written before */
+bool
+read(const char* path, std::map<std::string, Metrics>& results)
+{
+    std::ifstream istr(path);
+    if (!istr) {
+        std::cerr << "Error opening baseline file " << path << std::endl;
+        return false;
+    }
+    std::string line;
+    while (std::getline(istr, line)) {
+        const std::string key = "{\"file\":\"";
+        if (line.compare(0, key.size(), key) != 0) {
+            continue;
+        }
+        Metrics& metrics = results[muddoc::string(line, "file")];
+        metrics.parse = number(line, "parse");
+        metrics.traverse = number(line, "traverse");
+        metrics.bytes = number(line, "bytes");
+        metrics.warnings = number(line, "warnings");
+        metrics.seconds = number(line, "seconds");
+        metrics.peak = number(line, "peak");
+    }
+    return true;
+}
+
+/* Report a metric that regressed beyond the threshold */
+bool
+regressed(const char* file, const char* metric, double before, double after,
+        double threshold, double minimum)
+{
+    // Ignore differences that are too small to be measured reliably.
+    if (after - before <= minimum ||
+        after <= before * (1 + threshold / 100))
+    {
+        return false;
+    }
+    std::stringstream change;
+    change << std::fixed << std::setprecision(1)
+           << (before > 0 ? (after - before) * 100 / before : 100.0);
+    std::cout << "regression: " << file << " " << metric << " " << before
+              << " -> " << after << " (+" << change.str() << "%)"
+              << std::endl;
+    return true;
+}
+
+/* Compare the results with the baseline */
+bool
+compare(const Options& options, const std::vector<Entry>& entries,
+        const std::vector<Metrics>& results)
+{
+    std::map<std::string, Metrics> baseline;
+    if (!read(options.baseline, baseline)) {
+        return false;
+    }
+    bool ok = true;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const char* name = entries[i].name.c_str();
+        auto iter = baseline.find(name);
+        if (iter == baseline.end()) {
+            std::cout << "new: " << name << std::endl;
+            continue;
+        }
+        const Metrics& before = iter->second;
+        const Metrics& after = results[i];
+        ok = !regressed(name, "parse", before.parse, after.parse,
+                        options.threshold, 0.001) && ok;
+        ok = !regressed(name, "traverse", before.traverse, after.traverse,
+                        options.threshold, 0.001) && ok;
+        ok = !regressed(name, "seconds", before.seconds, after.seconds,
+                        options.threshold, 0.001) && ok;
+        ok = !regressed(name, "bytes", before.bytes, after.bytes,
+                        options.threshold, 0) && ok;
+        ok = !regressed(name, "peak", before.peak, after.peak,
+                        options.threshold, 0) && ok;
+        ok = !regressed(name, "warnings", before.warnings, after.warnings,
+                        0, 0) && ok;
+    }
+    return ok;
+}
+
+void
+help(const char* msg = nullptr)
+{
+    static const char* usage =
+R"(Usage: muddoc-corpus [OPTIONS]
+
+Document a fixed corpus of real headers, one file at a time, and output the
+parse time, traversal time, output size, number of warnings, end-to-end time
+and peak memory of each file in JSON.
+
+OPTIONS:
+    --help, -h          Show this help.
+    --muddoc PATH       The muddoc executable. Defaults to ./muddoc.
+    --src DIR           Include the headers of muddoc in DIR.
+    --llvm DIR          Include the clang and LLVM headers in the include
+                        folder DIR.
+    --libstdc++ DIR     The folder of the libstdc++ headers. Defaults to the
+                        most recent version in /usr/include/c++.
+    --output, -o FILE   Write the results to FILE instead of the standard
+                        output.
+    --baseline FILE     Compare the results with the earlier results in FILE
+                        and fail if any of them regressed.
+    --threshold PCT     Only report a time, output size or peak memory that
+                        regressed by more than PCT percent.
+                        Defaults to 10. Any additional warning is reported.
+    --repetitions N     Take the median time of N runs. Defaults to 3.
+)";
+    if (msg != nullptr) {
+        std::cerr << msg << std::endl;
+        std::cerr << usage;
+        ::exit(1);
+    }
+    std::cout << usage;
+}
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+    Options options;
+    options.libstdcxx = libstdcxx();
+    while (--argc && (*++argv)[0] == '-') {
+        if (::strcmp(*argv, "--help") == 0 || ::strcmp(*argv, "-h") == 0) {
+            help();
+            return 0;
+        }
+        else
+        if (::strcmp(*argv, "--muddoc") == 0) {
+            if (argc <= 1) {
+                help("Option --muddoc requires an argument.");
+            }
+            --argc, ++argv;
+            options.muddoc = *argv;
+        }
+        else
+        if (::strcmp(*argv, "--src") == 0) {
+            if (argc <= 1) {
+                help("Option --src requires an argument.");
+            }
+            --argc, ++argv;
+            options.src = *argv;
+        }
+        else
+        if (::strcmp(*argv, "--llvm") == 0) {
+            if (argc <= 1) {
+                help("Option --llvm requires an argument.");
+            }
+            --argc, ++argv;
+            options.llvm = *argv;
+        }
+        else
+        if (::strcmp(*argv, "--libstdc++") == 0) {
+            if (argc <= 1) {
+                help("Option --libstdc++ requires an argument.");
+            }
+            --argc, ++argv;
+            options.libstdcxx = *argv;
+        }
+        else
+        if (::strcmp(*argv, "--output") == 0 || ::strcmp(*argv, "-o") == 0) {
+            if (argc <= 1) {
+                help("Option --output,-o requires an argument.");
+            }
+            --argc, ++argv;
+            options.output = *argv;
+        }
+        else
+        if (::strcmp(*argv, "--baseline") == 0) {
+            if (argc <= 1) {
+                help("Option --baseline requires an argument.");
+            }
+            --argc, ++argv;
+            options.baseline = *argv;
+        }
+        else
+        if (::strcmp(*argv, "--threshold") == 0) {
+            if (argc <= 1) {
+                help("Option --threshold requires an argument.");
+            }
+            --argc, ++argv;
+            options.threshold = ::atof(*argv);
+            if (options.threshold < 0) {
+                help("Option --threshold requires a positive number.");
+            }
+        }
+        else
+        if (::strcmp(*argv, "--repetitions") == 0) {
+            if (argc <= 1) {
+                help("Option --repetitions requires an argument.");
+            }
+            --argc, ++argv;
+            options.repetitions = static_cast<unsigned>(::atoi(*argv));
+            if (options.repetitions == 0) {
+                help("Option --repetitions requires a positive number.");
+            }
+        }
+        else {
+            std::stringstream sstr;
+            sstr << "Unknown option '" << *argv << "'";
+            help(sstr.str().c_str());
+        }
+    }
+    std::vector<Entry> entries = corpus(options);
+    if (entries.empty()) {
+        help("The corpus is empty.");
+    }
+
+    // The output of muddoc lives in a temporary folder.
+    std::string folder =
+        (std::filesystem::temp_directory_path() / "muddoc-corpus.XXXXXX");
+    if (::mkdtemp(folder.data()) == nullptr) {
+        std::cerr << "Unable to create a temporary folder" << std::endl;
+        return 1;
+    }
+    options.folder = folder;
+    std::vector<Metrics> results(entries.size());
+    bool ok = true;
+    for (size_t i = 0; i < entries.size() && ok; ++i) {
+        ok = measure(options, entries[i], results[i]);
+    }
+    std::filesystem::remove_all(options.folder);
+    if (!ok) {
+        return 1;
+    }
+
+    // Output the results before comparing, such that they can become the
+    // next baseline.
+    if (options.output != nullptr) {
+        std::ofstream file(options.output);
+        if (!file) {
+            std::cerr << "Error opening output file " << options.output
+                      << std::endl;
+            return 1;
+        }
+        write(file, options, entries, results);
+    }
+    else {
+        write(std::cout, options, entries, results);
+    }
+    if (options.baseline != nullptr && !compare(options, entries, results)) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,457 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "process.h"
+#include "results.h"
+
+/*
+ * Performance regression gate. The micro-benchmarks and the corpus benchmark
+ * are run a number of times, and the median of each metric, with a 95%
+ * confidence interval, is compared with a baseline. A metric regresses when
+ * its whole confidence interval is worse than the median of the baseline by
+ * more than the threshold, such that noise does not fail the gate.
+ *
+ * The baseline is only ever written on request, with --update. Without a
+ * baseline there is nothing to compare with, so the gate fails, such that
+ * it cannot pass by accident. As the baseline is specific to the machine it
+ * is recorded on, a machine without one can skip the gate explicitly, with
+ * --allow-missing.
+ */
+
+namespace {
+
+using muddoc::number;
+using muddoc::slurp;
+
+/* A metric that is gated */
+struct Metric
+{
+    std::string name;       /* The name of the metric */
+    const char* unit;       /* The unit of the values */
+    bool higher;            /* True if a higher value is better */
+};
+
+/* The micro-benchmarks that are gated, by their throughput or time */
+const Metric bench_metrics[] = {
+    { "escape/plain", "MB/s", true },
+    { "escape/markup", "MB/s", true },
+    { "traverse/paragraphs", "ns/declaration", false },
+    { "traverse/verbatim", "ns/declaration", false },
+    { "traverse/parameters", "ns/declaration", false }
+};
+
+/* The corpus metrics that are gated, over all files */
+const Metric corpus_metrics[] = {
+    { "corpus/seconds", "s", false },
+    { "corpus/traverse", "s", false },
+    { "corpus/peak", "MB", false }
+};
+
+/* The summary of the samples of a metric */
+struct Summary
+{
+    double median = 0;
+    double lower = 0;
+    double upper = 0;
+    unsigned samples = 0;
+};
+
+/* The options of the gate */
+struct Options
+{
+    std::filesystem::path bench = "./muddoc-bench";
+    std::filesystem::path corpus = "./muddoc-corpus";
+    std::filesystem::path muddoc = "./muddoc";
+    std::string src;
+    std::string llvm;
+    std::filesystem::path folder;
+    const char* baseline = nullptr;
+    bool update = false;
+    bool missing = false;
+    double threshold = 5;
+    unsigned repetitions = 5;
+};
+
+/* Run the micro-benchmarks once and add their samples */
+bool
+bench(const Options& options,
+        std::map<std::string, std::vector<double>>& samples)
+{
+    std::filesystem::path output = options.folder / "bench.json";
+    muddoc::Usage usage;
+    if (!muddoc::execute({ options.bench, "--output", output }, usage)) {
+        return false;
+    }
+    std::istringstream istr(slurp(output));
+    std::string line;
+    while (std::getline(istr, line)) {
+        std::string name = muddoc::string(line, "name");
+        if (name.compare(0, 7, "escape/") == 0) {
+            samples[name].push_back(number(line, "bytes_per_second") / 1e6);
+        }
+        else
+        if (name.compare(0, 9, "traverse/") == 0) {
+            samples[name].push_back(number(line, "ns_per_op"));
+        }
+    }
+    return true;
+}
+
+/* Run the corpus benchmark once and add its samples */
+bool
+corpus(const Options& options,
+        std::map<std::string, std::vector<double>>& samples)
+{
+    std::filesystem::path output = options.folder / "corpus.json";
+    std::vector<std::string> args = {
+        options.corpus, "--muddoc", options.muddoc, "--repetitions", "1",
+        "--output", output
+    };
+    if (!options.src.empty()) {
+        args.insert(args.end(), { "--src", options.src });
+    }
+    if (!options.llvm.empty()) {
+        args.insert(args.end(), { "--llvm", options.llvm });
+    }
+    muddoc::Usage usage;
+    if (!muddoc::execute(args, usage)) {
+        return false;
+    }
+
+    // The times add up over the files, the peak memory does not.
+    double seconds = 0, traverse = 0, peak = 0;
+    std::istringstream istr(slurp(output));
+    std::string line;
+    while (std::getline(istr, line)) {
+        if (muddoc::string(line, "file").empty()) {
+            continue;
+        }
+        seconds += number(line, "seconds");
+        traverse += number(line, "traverse");
+        peak = std::max(peak, number(line, "peak") / 1e6);
+    }
+    samples["corpus/seconds"].push_back(seconds);
+    samples["corpus/traverse"].push_back(traverse);
+    samples["corpus/peak"].push_back(peak);
+    return true;
+}
+
+/* The median and its distribution-free 95% confidence interval */
+Summary
+summarize(std::vector<double> values)
+{
+    Summary summary;
+    size_t n = values.size();
+    if (n == 0) {
+        return summary;
+    }
+    std::sort(values.begin(), values.end());
+    summary.median = n % 2 ? values[n / 2]
+                           : (values[n / 2 - 1] + values[n / 2]) / 2;
+
+    // The ranks of the bounds follow from the normal approximation of the
+    // binomial distribution of the number of values below the median.
+    double spread = 1.96 * std::sqrt(double(n)) / 2;
+    long lower = std::lround(std::floor(n / 2.0 - spread));
+    long upper = std::lround(std::ceil(n / 2.0 + spread));
+    summary.lower = values[std::clamp<long>(lower, 0, n - 1)];
+    summary.upper = values[std::clamp<long>(upper, 0, n - 1)];
+    summary.samples = n;
+    return summary;
+}
+
+/* Write the summaries as the new baseline */
+bool
+update(const char* path, const std::vector<Metric>& metrics,
+        const std::map<std::string, Summary>& summaries)
+{
+    std::ofstream ostr(path);
+    if (!ostr) {
+        std::cerr << "Error opening baseline file " << path << std::endl;
+        return false;
+    }
+    ostr << "{\"metrics\":[";
+    for (size_t i = 0; i < metrics.size(); ++i) {
+        const Metric& metric = metrics[i];
+        const Summary& summary = summaries.at(metric.name);
+        ostr << (i > 0 ? "," : "") << "\n{\"metric\":\"" << metric.name
+             << "\",\"unit\":\"" << metric.unit
+             << "\",\"median\":" << summary.median
+             << ",\"lower\":" << summary.lower
+             << ",\"upper\":" << summary.upper
+             << ",\"samples\":" << summary.samples << "}";
+    }
+    ostr << "\n]}" << std::endl;
+    std::cout << "Updated the baseline " << path << std::endl;
+    return true;
+}
+
+/* Compare the summaries with the baseline and report the differences */
+bool
+compare(const char* path, double threshold,
+        const std::vector<Metric>& metrics,
+        const std::map<std::string, Summary>& summaries)
+{
+    std::map<std::string, Summary> baseline;
+    std::istringstream istr(slurp(path));
+    std::string line;
+    while (std::getline(istr, line)) {
+        std::string name = muddoc::string(line, "metric");
+        if (!name.empty()) {
+            Summary& summary = baseline[name];
+            summary.median = number(line, "median");
+            summary.lower = number(line, "lower");
+            summary.upper = number(line, "upper");
+            summary.samples = number(line, "samples");
+        }
+    }
+
+    bool ok = true;
+    std::cout << std::left << std::setw(24) << "metric"
+              << std::setw(16) << "unit" << std::right
+              << std::setw(12) << "baseline" << std::setw(12) << "current"
+              << std::setw(26) << "95% interval" << std::setw(10) << "change"
+              << "\n";
+    for (const auto& metric: metrics) {
+        const Summary& current = summaries.at(metric.name);
+        auto iter = baseline.find(metric.name);
+        std::stringstream interval;
+        interval << std::setprecision(4) << "["
+                 << current.lower << ", " << current.upper << "]";
+        std::cout << std::left << std::setw(24) << metric.name
+                  << std::setw(16) << metric.unit << std::right
+                  << std::setprecision(4);
+        if (iter == baseline.end()) {
+            std::cout << std::setw(12) << "-" << std::setw(12)
+                      << current.median << std::setw(26) << interval.str()
+                      << std::setw(10) << "-" << "  new\n";
+            continue;
+        }
+        const Summary& before = iter->second;
+        double change = before.median != 0
+            ? (current.median - before.median) * 100 / before.median : 0;
+
+        // Only regress if the whole interval is beyond the threshold.
+        bool regressed = metric.higher
+            ? current.upper < before.median * (1 - threshold / 100)
+            : current.lower > before.median * (1 + threshold / 100);
+        bool improved = metric.higher
+            ? current.lower > before.median * (1 + threshold / 100)
+            : current.upper < before.median * (1 - threshold / 100);
+        std::stringstream percentage;
+        percentage << std::fixed << std::setprecision(1) << std::showpos
+                   << change << "%";
+        std::cout << std::setw(12) << before.median << std::setw(12)
+                  << current.median << std::setw(26) << interval.str()
+                  << std::setw(10) << percentage.str()
+                  << (regressed ? "  REGRESSED" : improved ? "  improved" : "")
+                  << "\n";
+        ok = ok && !regressed;
+    }
+    if (!ok) {
+        std::cout << "Performance regressed by more than " << threshold
+                  << "% against " << path << std::endl;
+    }
+    return ok;
+}
+
+void
+help(const char* msg = nullptr)
+{
+    static const char* usage =
+R"(Usage: muddoc-perfcheck [OPTIONS] --baseline FILE
+
+Run the micro-benchmarks and the corpus benchmark a number of times and
+compare the median of each metric with the baseline in FILE. Fail if the
+confidence interval of any metric is worse than the baseline by more than
+the threshold. If there is no FILE, the check fails, unless it is allowed
+to be missing.
+
+OPTIONS:
+    --help, -h          Show this help.
+    --baseline FILE     The baseline to compare with, or to update.
+    --update            Write the results as the new baseline instead of
+                        comparing with it.
+    --allow-missing     Skip the comparison if there is no baseline, rather
+                        than failing.
+    --threshold PCT     The regression that is tolerated in percent.
+                        Defaults to 5.
+    --repetitions N     Run the benchmarks N times. Defaults to 5.
+    --bench PATH        The micro-benchmarks. Defaults to ./muddoc-bench.
+    --corpus PATH       The corpus benchmark. Defaults to ./muddoc-corpus.
+    --muddoc PATH       The muddoc executable. Defaults to ./muddoc.
+    --src DIR           Include the headers of muddoc in DIR in the corpus.
+    --llvm DIR          Include the clang and LLVM headers in the include
+                        folder DIR in the corpus.
+)";
+    if (msg != nullptr) {
+        std::cerr << msg << std::endl;
+        std::cerr << usage;
+        ::exit(1);
+    }
+    std::cout << usage;
+}
+
+/* Get the argument of an option */
+const char*
+argument(int& argc, char**& argv)
+{
+    if (argc <= 1) {
+        std::stringstream sstr;
+        sstr << "Option " << *argv << " requires an argument.";
+        help(sstr.str().c_str());
+    }
+    --argc, ++argv;
+    return *argv;
+}
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+    Options options;
+    while (--argc && (*++argv)[0] == '-') {
+        if (::strcmp(*argv, "--help") == 0 || ::strcmp(*argv, "-h") == 0) {
+            help();
+            return 0;
+        }
+        else
+        if (::strcmp(*argv, "--baseline") == 0) {
+            options.baseline = argument(argc, argv);
+        }
+        else
+        if (::strcmp(*argv, "--update") == 0) {
+            options.update = true;
+        }
+        else
+        if (::strcmp(*argv, "--allow-missing") == 0) {
+            options.missing = true;
+        }
+        else
+        if (::strcmp(*argv, "--threshold") == 0) {
+            options.threshold = ::atof(argument(argc, argv));
+            if (options.threshold <= 0) {
+                help("Option --threshold requires a positive number.");
+            }
+        }
+        else
+        if (::strcmp(*argv, "--repetitions") == 0) {
+            int repetitions = ::atoi(argument(argc, argv));
+            if (repetitions <= 0) {
+                help("Option --repetitions requires a positive number.");
+            }
+            options.repetitions = static_cast<unsigned>(repetitions);
+        }
+        else
+        if (::strcmp(*argv, "--bench") == 0) {
+            options.bench = argument(argc, argv);
+        }
+        else
+        if (::strcmp(*argv, "--corpus") == 0) {
+            options.corpus = argument(argc, argv);
+        }
+        else
+        if (::strcmp(*argv, "--muddoc") == 0) {
+            options.muddoc = argument(argc, argv);
+        }
+        else
+        if (::strcmp(*argv, "--src") == 0) {
+            options.src = argument(argc, argv);
+        }
+        else
+        if (::strcmp(*argv, "--llvm") == 0) {
+            options.llvm = argument(argc, argv);
+        }
+        else {
+            std::stringstream sstr;
+            sstr << "Unknown option '" << *argv << "'";
+            help(sstr.str().c_str());
+        }
+    }
+    if (options.baseline == nullptr) {
+        help("Option --baseline is required.");
+    }
+
+    // Check for the baseline before spending minutes on the benchmarks.
+    if (!options.update && !std::filesystem::exists(options.baseline)) {
+        if (options.missing) {
+            std::cout << "Skipping the performance check: there is no "
+                      << "baseline " << options.baseline << std::endl;
+            return 0;
+        }
+        std::cerr << "There is no baseline " << options.baseline
+                  << ", record one with 'make perfcheck-update'" << std::endl;
+        return 1;
+    }
+
+    // The results of each run live in a temporary folder.
+    std::string folder =
+        (std::filesystem::temp_directory_path() / "muddoc-perfcheck.XXXXXX");
+    if (::mkdtemp(folder.data()) == nullptr) {
+        std::cerr << "Unable to create a temporary folder" << std::endl;
+        return 1;
+    }
+    options.folder = folder;
+    std::map<std::string, std::vector<double>> samples;
+    bool ok = true;
+    for (unsigned i = 0; i < options.repetitions && ok; ++i) {
+        std::cerr << "Run " << i + 1 << " of " << options.repetitions
+                  << std::endl;
+        ok = bench(options, samples) && corpus(options, samples);
+    }
+    std::filesystem::remove_all(options.folder);
+    if (!ok) {
+        return 1;
+    }
+
+    std::vector<Metric> metrics(std::begin(bench_metrics),
+            std::end(bench_metrics));
+    metrics.insert(metrics.end(), std::begin(corpus_metrics),
+            std::end(corpus_metrics));
+    std::map<std::string, Summary> summaries;
+    for (const auto& metric: metrics) {
+        summaries[metric.name] = summarize(samples[metric.name]);
+    }
+    if (options.update) {
+        return update(options.baseline, metrics, summaries) ? 0 : 1;
+    }
+    return compare(options.baseline, options.threshold, metrics, summaries)
+        ? 0 : 1;
+}
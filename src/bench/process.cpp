@@ -0,0 +1,76 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "process.h"
+
+namespace muddoc {
+
+bool
+execute(const std::vector<std::string>& args, Usage& usage)
+{
+    std::vector<char*> argv;
+    for (const auto& arg: args) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    auto start = std::chrono::steady_clock::now();
+    pid_t pid = ::fork();
+    if (pid < 0) {
+        std::cerr << "Unable to start " << args[0] << ": "
+                  << ::strerror(errno) << std::endl;
+        return false;
+    }
+    if (pid == 0) {
+        int null = ::open("/dev/null", O_WRONLY);
+        ::dup2(null, STDOUT_FILENO);
+        ::dup2(null, STDERR_FILENO);
+        ::execv(argv[0], argv.data());
+        ::_exit(127);
+    }
+    int status = 0;
+    struct rusage resources;
+    if (::wait4(pid, &status, 0, &resources) < 0 ||
+        !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    {
+        std::cerr << "Unable to run " << args[0] << std::endl;
+        return false;
+    }
+    auto stop = std::chrono::steady_clock::now();
+    usage.seconds = std::chrono::duration<double>(stop - start).count();
+    usage.peak = uint64_t(resources.ru_maxrss) * 1024;
+    return true;
+}
+
+} // namespace muddoc
@@ -0,0 +1,64 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#ifndef _MUDDOC_BENCH_PROCESS_H_
+#define _MUDDOC_BENCH_PROCESS_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace muddoc {
+
+/**
+ * @brief The resources used by a child process.
+ */
+struct Usage
+{
+    /** The elapsed wall clock time in seconds */
+    double seconds = 0;
+
+    /** The peak resident set size in bytes */
+    uint64_t peak = 0;
+};
+
+/**
+ * @brief Run a program to completion and measure its resources.
+ *
+ * @details
+ * The program is run as a child process with its standard output and error
+ * discarded, such that only the resources of the program itself are
+ * measured.
+ *
+ * @param args The path of the program, followed by its arguments.
+ * @param usage The resources that the program used.
+ * @return True if the program ran and exited with a zero status.
+ */
+bool execute(const std::vector<std::string>& args, Usage& usage);
+
+} // namespace muddoc
+
+#endif /* _MUDDOC_BENCH_PROCESS_H_ */
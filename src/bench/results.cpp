@@ -0,0 +1,65 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include "results.h"
+
+namespace muddoc {
+
+std::string
+slurp(const std::filesystem::path& path)
+{
+    std::ifstream istr(path);
+    std::stringstream sstr;
+    sstr << istr.rdbuf();
+    return sstr.str();
+}
+
+double
+number(const std::string& text, const std::string& key, size_t from)
+{
+    size_t pos = text.find("\"" + key + "\":", from);
+    if (pos == std::string::npos) {
+        return 0;
+    }
+    return ::strtod(text.c_str() + pos + key.size() + 3, nullptr);
+}
+
+std::string
+string(const std::string& text, const std::string& key)
+{
+    std::string prefix = "\"" + key + "\":\"";
+    size_t start = text.find(prefix);
+    if (start == std::string::npos) {
+        return std::string();
+    }
+    start += prefix.size();
+    return text.substr(start, text.find('"', start) - start);
+}
+
+} // namespace muddoc
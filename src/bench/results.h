@@ -0,0 +1,73 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#ifndef _MUDDOC_BENCH_RESULTS_H_
+#define _MUDDOC_BENCH_RESULTS_H_
+
+#include <filesystem>
+#include <string>
+
+namespace muddoc {
+
+/*
+ * The benchmarks write their results in JSON with one record per line, such
+ * that they can be read back line by line without a full JSON parser.
+ */
+
+/**
+ * @brief Read a whole file.
+ *
+ * @param path The file to read.
+ * @return The content of the file, or an empty string if it cannot be read.
+ */
+std::string slurp(const std::filesystem::path& path);
+
+/**
+ * @brief Get the number of a key in a text of JSON.
+ *
+ * @param text The JSON text.
+ * @param key The key of the number.
+ * @param from The position to start searching for the key.
+ * @return The number, or zero if the key is not found.
+ */
+double number(const std::string& text, const std::string& key,
+        size_t from = 0);
+
+/**
+ * @brief Get the string of a key in a text of JSON.
+ *
+ * @details
+ * The string is not unescaped, the results never contain escaped text.
+ *
+ * @param text The JSON text.
+ * @param key The key of the string.
+ * @return The string, or an empty string if the key is not found.
+ */
+std::string string(const std::string& text, const std::string& key);
+
+} // namespace muddoc
+
+#endif /* _MUDDOC_BENCH_RESULTS_H_ */
@@ -0,0 +1,400 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "process.h"
+
+/*
+ * Scaling benchmark of the end-to-end pipeline. Synthetic, fully commented
+ * headers are generated with one parameter varied at a time, and muddoc is
+ * run over each of them as a separate process. The throughput and the peak
+ * memory are written as CSV, together with a gnuplot script that plots them
+ * against each parameter, such that any superlinear behaviour stands out.
+ */
+
+namespace {
+
+/* The shape of a generated header */
+struct Shape
+{
+    unsigned classes = 16;      /* The classes in the header */
+    unsigned depth = 2;         /* The nesting depth of the namespaces */
+    unsigned methods = 8;       /* The methods per class */
+    unsigned lines = 4;         /* The comment lines per declaration */
+};
+
+/* The options of the benchmark run */
+struct Options
+{
+    std::filesystem::path muddoc = "./muddoc";
+    std::filesystem::path folder;
+    const char* output = nullptr;
+    const char* plot = nullptr;
+    unsigned steps = 6;
+    unsigned repetitions = 3;
+    unsigned jobs = std::max(1u, std::thread::hardware_concurrency());
+};
+
+/* The outcome of running muddoc once */
+struct Run
+{
+    double seconds;
+    uint64_t bytes;
+    uint64_t peak;
+};
+
+/* The comment lines of a declaration */
+void
+comment(std::ostream& ostr, const char* indent, unsigned lines)
+{
+    for (unsigned i = 0; i < lines; ++i) {
+        ostr << indent << " * This line describes the behaviour of the "
+             << "declaration in some detail, line " << i << ".\n";
+    }
+}
+
+/* Generate a header and return the number of declarations */
+uint64_t
+generate(const std::filesystem::path& path, const Shape& shape)
+{
+    std::ofstream ostr(path);
+    for (unsigned i = 0; i < shape.depth; ++i) {
+        ostr << "/**\n * @brief Namespace level " << i << ".\n";
+        comment(ostr, "", shape.lines);
+        ostr << " */\nnamespace level" << i << " {\n\n";
+    }
+    for (unsigned i = 0; i < shape.classes; ++i) {
+        ostr << "/**\n * @brief Class " << i << ".\n *\n * @details\n";
+        comment(ostr, "", shape.lines);
+        ostr << " */\nclass Class" << i << "\n{\npublic:\n";
+        for (unsigned j = 0; j < shape.methods; ++j) {
+            ostr << "    /**\n     * @brief Method " << j << ".\n"
+                 << "     *\n     * @details\n";
+            comment(ostr, "    ", shape.lines);
+            ostr << "     *\n"
+                 << "     * @param a The first parameter.\n"
+                 << "     * @param b The second parameter.\n"
+                 << "     * @param c The third parameter.\n"
+                 << "     * @return The result.\n"
+                 << "     */\n"
+                 << "    int method" << j
+                 << "(int a, const char* b, double c);\n\n";
+        }
+        ostr << "};\n\n";
+    }
+    for (unsigned i = 0; i < shape.depth; ++i) {
+        ostr << "}\n";
+    }
+    return shape.depth + shape.classes +
+        uint64_t(shape.classes) * shape.methods;
+}
+
+/* Run muddoc over the files with a number of jobs */
+bool
+run(const Options& options, const std::vector<std::string>& files,
+        unsigned jobs, Run& result)
+{
+    std::filesystem::path output = options.folder / "output.xml";
+    std::vector<std::string> args = {
+        options.muddoc, "-b", options.folder, "-o", output,
+        "-j", std::to_string(jobs)
+    };
+    args.insert(args.end(), files.begin(), files.end());
+
+    // Only the throughput matters, the warnings are discarded.
+    muddoc::Usage usage;
+    if (!muddoc::execute(args, usage)) {
+        std::cerr << "Unable to run " << options.muddoc << " over "
+                  << options.folder << std::endl;
+        return false;
+    }
+    result.seconds = usage.seconds;
+    result.bytes = std::filesystem::file_size(output);
+    result.peak = usage.peak;
+    return true;
+}
+
+/* Measure a point of a parameter and output it as a CSV row */
+bool
+measure(const Options& options, std::ostream& csv, const char* parameter,
+        unsigned value, const std::vector<std::string>& files,
+        uint64_t declarations, unsigned jobs)
+{
+    // Take the median time and the largest peak memory of the runs.
+    std::vector<Run> runs(options.repetitions);
+    for (auto& result: runs) {
+        if (!run(options, files, jobs, result)) {
+            return false;
+        }
+    }
+    std::sort(runs.begin(), runs.end(), [](const Run& lhs, const Run& rhs) {
+        return lhs.seconds < rhs.seconds;
+    });
+    Run median = runs[runs.size() / 2];
+    for (const auto& result: runs) {
+        median.peak = std::max(median.peak, result.peak);
+    }
+    csv << parameter << "," << value << "," << declarations << ","
+        << median.seconds << "," << declarations / median.seconds << ","
+        << median.bytes / 1e6 / median.seconds << ","
+        << median.peak / 1e6 << std::endl;
+    std::cerr << parameter << "=" << value << ": " << median.seconds << " s"
+              << std::endl;
+    return true;
+}
+
+/* Vary one parameter of the shape by doubling it */
+bool
+sweep(const Options& options, std::ostream& csv, const char* parameter,
+        unsigned Shape::* field)
+{
+    for (unsigned i = 0, value = 1; i < options.steps; ++i, value *= 2) {
+        Shape shape;
+        shape.*field = value;
+        uint64_t declarations =
+            generate(options.folder / "scale.h", shape);
+        if (!measure(options, csv, parameter, value, { "scale.h" },
+                     declarations, 1))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Vary the number of jobs over as many files */
+bool
+threads(const Options& options, std::ostream& csv)
+{
+    std::vector<std::string> files;
+    uint64_t declarations = 0;
+    for (unsigned i = 0; i < options.jobs; ++i) {
+        files.push_back("scale" + std::to_string(i) + ".h");
+        declarations += generate(options.folder / files.back(), Shape());
+    }
+    for (unsigned jobs = 1; jobs <= options.jobs; jobs *= 2) {
+        if (!measure(options, csv, "jobs", jobs, files, declarations, jobs)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Write a gnuplot script that plots the CSV against each parameter */
+void
+plot(std::ostream& ostr, const char* csv)
+{
+    static const char* parameters[] = {
+        "classes", "depth", "methods", "lines", "jobs"
+    };
+    ostr << "set datafile separator ','\n"
+         << "set terminal pngcairo size 800,500\n"
+         << "set logscale x 2\n"
+         << "set ylabel 'throughput'\n"
+         << "set y2label 'peak memory (MB)'\n"
+         << "set ytics nomirror\n"
+         << "set y2tics\n"
+         << "set key left top\n";
+    for (const char* parameter: parameters) {
+        ostr << "set output 'scale-" << parameter << ".png'\n"
+             << "set xlabel '" << parameter << "'\n"
+             << "plot '" << csv << "' using 2:(strcol(1) eq '" << parameter
+             << "' ? $5 : NaN) with linespoints title 'declarations/s', \\\n"
+             << "     '' using 2:(strcol(1) eq '" << parameter
+             << "' ? $6 * 1000 : NaN) with linespoints"
+             << " title 'output kB/s', \\\n"
+             << "     '' using 2:(strcol(1) eq '" << parameter
+             << "' ? $7 : NaN) axes x1y2 with linespoints"
+             << " title 'peak memory'\n";
+    }
+}
+
+void
+help(const char* msg = nullptr)
+{
+    static const char* usage =
+R"(Usage: muddoc-scale [OPTIONS]
+
+Run muddoc over generated headers while varying the number of classes, the
+nesting depth of the namespaces, the methods per class, the comment lines per
+declaration and the number of jobs, one at a time. The throughput and peak
+memory are written as CSV.
+
+OPTIONS:
+    --help, -h          Show this help.
+    --muddoc PATH       The muddoc executable. Defaults to ./muddoc.
+    --output, -o FILE   Write the CSV to FILE instead of the standard output.
+    --plot FILE         Write a gnuplot script to FILE that plots the CSV of
+                        --output.
+    --steps N           Double each parameter N times, starting at 1.
+                        Defaults to 6.
+    --repetitions N     Take the median time of N runs. Defaults to 3.
+    --jobs, -j N        The largest number of jobs. Defaults to the number of
+                        processors.
+)";
+    if (msg != nullptr) {
+        std::cerr << msg << std::endl;
+        std::cerr << usage;
+        ::exit(1);
+    }
+    std::cout << usage;
+}
+
+/* Parse a positive number of an option */
+unsigned
+positive(const char* option, const char* arg)
+{
+    int value = ::atoi(arg);
+    if (value <= 0) {
+        std::stringstream sstr;
+        sstr << "Option " << option << " requires a positive number.";
+        help(sstr.str().c_str());
+    }
+    return static_cast<unsigned>(value);
+}
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+    Options options;
+    while (--argc && (*++argv)[0] == '-') {
+        if (::strcmp(*argv, "--help") == 0 || ::strcmp(*argv, "-h") == 0) {
+            help();
+            return 0;
+        }
+        else
+        if (::strcmp(*argv, "--muddoc") == 0) {
+            if (argc <= 1) {
+                help("Option --muddoc requires an argument.");
+            }
+            --argc, ++argv;
+            options.muddoc = *argv;
+        }
+        else
+        if (::strcmp(*argv, "--output") == 0 || ::strcmp(*argv, "-o") == 0) {
+            if (argc <= 1) {
+                help("Option --output,-o requires an argument.");
+            }
+            --argc, ++argv;
+            options.output = *argv;
+        }
+        else
+        if (::strcmp(*argv, "--plot") == 0) {
+            if (argc <= 1) {
+                help("Option --plot requires an argument.");
+            }
+            --argc, ++argv;
+            options.plot = *argv;
+        }
+        else
+        if (::strcmp(*argv, "--steps") == 0) {
+            if (argc <= 1) {
+                help("Option --steps requires an argument.");
+            }
+            --argc, ++argv;
+            options.steps = positive("--steps", *argv);
+        }
+        else
+        if (::strcmp(*argv, "--repetitions") == 0) {
+            if (argc <= 1) {
+                help("Option --repetitions requires an argument.");
+            }
+            --argc, ++argv;
+            options.repetitions = positive("--repetitions", *argv);
+        }
+        else
+        if (::strcmp(*argv, "--jobs") == 0 || ::strcmp(*argv, "-j") == 0) {
+            if (argc <= 1) {
+                help("Option --jobs,-j requires an argument.");
+            }
+            --argc, ++argv;
+            options.jobs = positive("--jobs,-j", *argv);
+        }
+        else {
+            std::stringstream sstr;
+            sstr << "Unknown option '" << *argv << "'";
+            help(sstr.str().c_str());
+        }
+    }
+    if (options.plot != nullptr && options.output == nullptr) {
+        help("Option --plot requires --output.");
+    }
+
+    std::ofstream file;
+    std::ostream* csv = &std::cout;
+    if (options.output != nullptr) {
+        file.open(options.output);
+        if (!file) {
+            std::cerr << "Error opening output file " << options.output
+                      << std::endl;
+            return 1;
+        }
+        csv = &file;
+    }
+
+    // The generated headers and the output live in a temporary folder.
+    std::string folder =
+        (std::filesystem::temp_directory_path() / "muddoc-scale.XXXXXX");
+    if (::mkdtemp(folder.data()) == nullptr) {
+        std::cerr << "Unable to create a temporary folder" << std::endl;
+        return 1;
+    }
+    options.folder = folder;
+
+    *csv << "parameter,value,declarations,seconds,declarations_per_second,"
+         << "output_mb_per_second,peak_memory_mb" << std::endl;
+    bool ok = sweep(options, *csv, "classes", &Shape::classes) &&
+              sweep(options, *csv, "depth", &Shape::depth) &&
+              sweep(options, *csv, "methods", &Shape::methods) &&
+              sweep(options, *csv, "lines", &Shape::lines) &&
+              threads(options, *csv);
+    std::filesystem::remove_all(options.folder);
+    if (!ok) {
+        return 1;
+    }
+
+    if (options.plot != nullptr) {
+        std::ofstream ostr(options.plot);
+        if (!ostr) {
+            std::cerr << "Error opening plot file " << options.plot
+                      << std::endl;
+            return 1;
+        }
+        plot(ostr, options.output);
+    }
+    return 0;
+}
@@ -0,0 +1,236 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#include <sstream>
+#include "binary.h"
+#include "descriptor.h"
+#include "symbols.h"
+#include "warn_error.h"
+
+namespace muddoc {
+
+BinarySink::BinarySink(std::ostream& ostr, bool strict)
+    : _ostr(ostr), _strict(strict), _symbols(nullptr), _size(0)
+{
+}
+
+void
+BinarySink::begin(const std::string& file, const SymbolIndex& symbols)
+{
+    static const char magic[] = { 'M', 'U', 'D', 'B', 1 };
+    _symbols = &symbols;
+    _unresolved.clear();
+    _reported.clear();
+    _ostr.write(magic, sizeof(magic));
+    _size += sizeof(magic);
+    byte('F');
+    string(file);
+}
+
+void
+BinarySink::end(const std::string& file, uint64_t hash)
+{
+    byte('X');
+    number(hash);
+    _symbols = nullptr;
+    if (_strict && !_unresolved.empty()) {
+        warn("unresolved-ref", SymbolIndex::summary(_unresolved));
+    }
+}
+
+void
+BinarySink::begin(const NamespaceDescriptor& descriptor)
+{
+    open('N', descriptor);
+}
+
+void
+BinarySink::end(const NamespaceDescriptor& descriptor)
+{
+    byte('X');
+    number(descriptor.hash());
+}
+
+void
+BinarySink::begin(const ClassDescriptor& descriptor)
+{
+    open('C', descriptor);
+    string(descriptor.path());
+    string(descriptor.declaration());
+}
+
+void
+BinarySink::end(const ClassDescriptor& descriptor)
+{
+    byte('X');
+    number(descriptor.hash());
+}
+
+void
+BinarySink::begin(const EnumDescriptor& descriptor)
+{
+    open('E', descriptor);
+}
+
+void
+BinarySink::end(const EnumDescriptor& descriptor)
+{
+    byte('X');
+    number(descriptor.hash());
+}
+
+/* Output a constructor, destructor or method, its comments follow as text
+ * records */
+template <typename T>
+void
+BinarySink::method(char type, const T& descriptor)
+{
+    open(type, descriptor);
+    string(descriptor.path());
+    string(descriptor.declaration());
+    number(descriptor.hash());
+}
+
+void
+BinarySink::method(const ConstructorDescriptor& descriptor)
+{
+    method('c', descriptor);
+}
+
+void
+BinarySink::method(const DestructorDescriptor& descriptor)
+{
+    method('d', descriptor);
+}
+
+void
+BinarySink::method(const MethodDescriptor& descriptor)
+{
+    method('m', descriptor);
+}
+
+void
+BinarySink::value(const EnumConstantDescriptor& descriptor)
+{
+    open('v', descriptor);
+    number(descriptor.hash());
+}
+
+void
+BinarySink::param(const ParamDescriptor& descriptor)
+{
+    byte('p');
+    number(descriptor.index());
+    string(descriptor.name());
+    text(descriptor.description());
+}
+
+void
+BinarySink::returns(const std::string& xml)
+{
+    byte('r');
+    text(xml);
+}
+
+void
+BinarySink::brief(const std::string& xml)
+{
+    byte('b');
+    text(xml);
+}
+
+void
+BinarySink::detailed(const std::string& xml)
+{
+    byte('t');
+    text(xml);
+}
+
+void
+BinarySink::open(char type, const Descriptor& descriptor)
+{
+    byte(type);
+    string(descriptor.name());
+    string(descriptor.qualified());
+    string(descriptor.usr());
+}
+
+void
+BinarySink::number(uint64_t value)
+{
+    // Unsigned LEB128, seven bits per byte with the high bit set on all but
+    // the last byte.
+    char bytes[10];
+    size_t count = 0;
+    do {
+        bytes[count] = static_cast<char>(value & 0x7f);
+        value >>= 7;
+        if (value != 0) {
+            bytes[count] |= static_cast<char>(0x80);
+        }
+        ++count;
+    } while (value != 0);
+    _ostr.write(bytes, count);
+    _size += count;
+}
+
+void
+BinarySink::string(const std::string& value)
+{
+    number(value.size());
+    _ostr.write(value.data(), value.size());
+    _size += value.size();
+}
+
+void
+BinarySink::text(const std::string& xml)
+{
+    // Resolve the cross-references in the text against the index of all
+    // the symbols, only the names that cannot be found are collected. The
+    // length of the resolved text is only known once it is resolved.
+    if (xml.find("<ref ") == std::string::npos) {
+        string(xml);
+        return;
+    }
+    std::ostringstream resolved;
+    std::vector<std::string> unresolved;
+    _symbols->resolve(xml, resolved, unresolved);
+    for (auto& ref: unresolved) {
+        if (_reported.insert(ref).second) {
+            _unresolved.push_back(std::move(ref));
+        }
+    }
+    string(resolved.str());
+}
+
+void
+BinarySink::byte(char value)
+{
+    _ostr.put(value);
+    ++_size;
+}
+
+} // namespace muddoc
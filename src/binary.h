@@ -0,0 +1,159 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#ifndef _MUDDOC_BINARY_H_
+#define _MUDDOC_BINARY_H_
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "sink.h"
+
+namespace muddoc {
+
+/** Forward declaration */
+class Descriptor;
+
+/**
+ * @brief Sink that outputs the documentation in a compact binary format.
+ *
+ * @details
+ * The documentation of a file is output as a sequence of records, one per
+ * event, such that a consumer can read it with a single pass and without a
+ * parser. The document starts with the magic "MUDB" and a version byte, 1.
+ * Each record is a type byte followed by its fields, where a number is an
+ * unsigned LEB128 varint and a string is its length in bytes as a number,
+ * followed by its UTF-8 bytes:
+ *
+ * @code
+ * 'F' FILE                                      the file starts
+ * 'N' NAME QUALIFIED USR                        a namespace starts
+ * 'C' NAME QUALIFIED USR PATH DECLARATION       a class starts
+ * 'E' NAME QUALIFIED USR                        an enumeration starts
+ * 'X' HASH                                      the file or scope ends
+ * 'c' NAME QUALIFIED USR PATH DECLARATION HASH  a constructor
+ * 'd' NAME QUALIFIED USR PATH DECLARATION HASH  a destructor
+ * 'm' NAME QUALIFIED USR PATH DECLARATION HASH  a method
+ * 'v' NAME QUALIFIED USR HASH                   an enumeration constant
+ * 'p' INDEX NAME BRIEF                          a described parameter
+ * 'r' TEXT                                      the description of the return
+ * 'b' TEXT                                      the brief description
+ * 't' TEXT                                      the detailed description
+ * @endcode
+ *
+ * The records follow the events of the @c Sink: the text records of a
+ * declaration follow its own record, and a scope is closed by an 'X' record
+ * after its members. A @c HASH is a number, 0 if the fingerprints are not
+ * computed. The text holds the same inline markup as the XML, with the
+ * cross-references resolved against the index of all the symbols of the
+ * file.
+ */
+class BinarySink: public Sink
+{
+public:
+    /**
+     * @brief Create a sink that outputs the binary format.
+     *
+     * @param ostr The stream to output the documentation to, which has to be
+     * opened in binary mode.
+     * @param strict True to warn about the references that cannot be
+     * resolved, false if only part of the file is documented or if another
+     * sink warns about them already.
+     */
+    BinarySink(std::ostream& ostr, bool strict = true);
+
+    /**
+     * @brief Output the event as a record, see @c Sink.
+     */
+    void begin(const std::string& file,
+            const SymbolIndex& symbols) override;
+    void end(const std::string& file, uint64_t hash) override;
+    void begin(const NamespaceDescriptor& descriptor) override;
+    void end(const NamespaceDescriptor& descriptor) override;
+    void begin(const ClassDescriptor& descriptor) override;
+    void end(const ClassDescriptor& descriptor) override;
+    void begin(const EnumDescriptor& descriptor) override;
+    void end(const EnumDescriptor& descriptor) override;
+    void method(const ConstructorDescriptor& descriptor) override;
+    void method(const DestructorDescriptor& descriptor) override;
+    void method(const MethodDescriptor& descriptor) override;
+    void value(const EnumConstantDescriptor& descriptor) override;
+    void param(const ParamDescriptor& descriptor) override;
+    void returns(const std::string& text) override;
+    void brief(const std::string& text) override;
+    void detailed(const std::string& text) override;
+
+    /**
+     * @brief Get the number of bytes that have been output.
+     *
+     * @return The number of bytes output so far.
+     */
+    uint64_t size() const override { return _size; }
+
+private:
+    /* Output the type of a record and the fields of a declaration */
+    void open(char type, const Descriptor& descriptor);
+
+    /* Output a record of a constructor, destructor or method */
+    template <typename T>
+    void method(char type, const T& descriptor);
+
+    /* Output a number */
+    void number(uint64_t value);
+
+    /* Output a string */
+    void string(const std::string& value);
+
+    /* Output a text, with its cross-references resolved */
+    void text(const std::string& xml);
+
+    /* Output a single byte */
+    void byte(char value);
+
+    /* The stream to output to */
+    std::ostream& _ostr;
+
+    /* True to warn about unresolved references */
+    bool _strict;
+
+    /* The symbols to resolve the references against, during a file */
+    const SymbolIndex* _symbols;
+
+    /* The names of the unresolved references, in order of appearance */
+    std::vector<std::string> _unresolved;
+
+    /* The names of the unresolved references, to report each once */
+    std::unordered_set<std::string> _reported;
+
+    /* The number of bytes output so far */
+    uint64_t _size;
+};
+
+} // namespace muddoc
+
+#endif /* _MUDDOC_BINARY_H_ */
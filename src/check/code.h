@@ -0,0 +1,80 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#ifndef _MUDDOC_CHECK_CODE_H_
+#define _MUDDOC_CHECK_CODE_H_
+
+namespace check {
+
+/**
+ * @brief A class with examples.
+ *
+ * @details
+ * The examples are verbatim blocks, that keep their indentation and their
+ * special characters, like <, > and &:
+ *
+ * @code
+ * Example example;
+ * if (example.size() < 2 && example.empty()) {
+ *     example.add("<value>");
+ * }
+ * @endcode
+ *
+ * The text after an example is a paragraph of its own.
+ */
+class Example
+{
+public:
+    /**
+     * @brief Add a value.
+     *
+     * @code
+     *   example.add("a");
+     *
+     *   example.add("b");
+     * @endcode
+     *
+     * @param value The value to add.
+     */
+    void add(const char* value);
+
+    /**
+     * @brief Check whether there are no values.
+     * @return True if no value has been added.
+     */
+    bool empty() const;
+
+    /**
+     * @brief Return the number of values.
+     * @details An empty example has a size of 0.
+     * @return The number of values.
+     */
+    unsigned size() const;
+};
+
+} // namespace check
+
+#endif /* _MUDDOC_CHECK_CODE_H_ */
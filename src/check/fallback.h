@@ -0,0 +1,77 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#ifndef _MUDDOC_CHECK_FALLBACK_H_
+#define _MUDDOC_CHECK_FALLBACK_H_
+
+namespace check {
+
+/**
+ * @brief A class with comments that cannot be scanned.
+ *
+ * @details
+ * These comments are parsed by clang, also when the comments are scanned,
+ * so they are never different.
+ */
+class Fallback
+{
+public:
+    /// @brief A line comment.
+    ///
+    /// Line comments are not scanned.
+    void line();
+
+    /**
+     * @brief A comment with <b>HTML</b> tags.
+     */
+    void html();
+
+    /**
+     * @brief A comment with a character reference, like &amp;.
+     */
+    void reference();
+
+    /**
+     * @brief A comment with other commands.
+     * @note Notes are not part of the subset.
+     * @warning Neither are warnings.
+     */
+    void other();
+
+    /**
+     * @brief A comment with a verbatim block.
+     * @verbatim
+     * Not a code block.
+     * @endverbatim
+     */
+    void verbatim();
+
+    void undocumented();
+};
+
+} // namespace check
+
+#endif /* _MUDDOC_CHECK_FALLBACK_H_ */
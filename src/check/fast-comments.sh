@@ -0,0 +1,60 @@
+#!/bin/sh
+#
+# ++ start-license-description ++
+#
+# Copyright (c) 2026 Stefan Sinnige.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+# ++ end-license-description ++
+#
+
+# Differential test of the fast comment path: document the fixture headers
+# with the comments both parsed by clang and scanned from the source text,
+# and fail on any comment of which the two descriptions differ. The fixtures
+# warn on purpose, so muddoc only fails on errors. Each header is checked
+# once with --lint and once with the output, which escapes the text and
+# resolves the references.
+#
+# Run by 'make check', with MUDDOC set to the muddoc to test.
+
+MUDDOC=${MUDDOC:-./muddoc}
+srcdir=${srcdir:-.}
+warnings=fast-comments.warnings
+output=fast-comments.xml
+status=0
+
+for header in code.h params.h inline.h fallback.h; do
+    for mode in --lint "--output $output"; do
+        if ! "$MUDDOC" $mode --fail-on error --check-fast-comments \
+                --warning-file "$warnings" --base "$srcdir/check" \
+                "$header"; then
+            echo "FAIL: muddoc $mode failed on $header" >&2
+            status=1
+        fi
+        if grep '\[fast-comment\]' "$warnings" >&2; then
+            echo "FAIL: the scanned comments of $header differ" \
+                "with $mode" >&2
+            status=1
+        fi
+    done
+done
+
+rm -f "$warnings" "$output"
+exit $status
@@ -0,0 +1,81 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#ifndef _MUDDOC_CHECK_INLINE_H_
+#define _MUDDOC_CHECK_INLINE_H_
+
+namespace check {
+
+/**
+ * @brief A class with @b bold, @e emphasized and @c code text.
+ *
+ * @details
+ * The inline commands also have their other spellings: @a argument,
+ * @em emphasis and @p parameter. A reference to @ref Other::method is
+ * resolved, and so is one to @ref Inline.
+ *
+ * Text can contain punctuation like "quotes", 'apostrophes', a < b, c > d
+ * and e & f, and words with an @@ or a \\ in them.
+ *
+ * @see Other, Other::method() for the details.
+ * @sa Inline
+ */
+class Inline
+{
+public:
+    /**
+     * @brief Return @c true if @p value is @b valid.
+     * @param value The value to check, see @ref Other.
+     * @return True if the value is valid.
+     */
+    bool valid(int value) const;
+};
+
+/**
+ * @brief Another class.
+ * @seealso the description of Inline for the details.
+ */
+class Other
+{
+public:
+    /**
+     * @brief A method that is referred to.
+     */
+    void method();
+};
+
+/**
+ * @brief An enumeration.
+ */
+enum Kind
+{
+    First,      /**< The @e first value */
+    Second      /**< The @e second value */
+};
+
+} // namespace check
+
+#endif /* _MUDDOC_CHECK_INLINE_H_ */
@@ -0,0 +1,92 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#ifndef _MUDDOC_CHECK_PARAMS_H_
+#define _MUDDOC_CHECK_PARAMS_H_
+
+namespace check {
+
+/**
+ * @brief A class with described parameters.
+ */
+class Params
+{
+public:
+    /**
+     * @brief Create an object.
+     *
+     * @param first The first parameter.
+     * @param second The second parameter, which is described over more
+     * than one line.
+     */
+    Params(int first, int second);
+
+    /**
+     * @brief Destructor.
+     */
+    ~Params();
+
+    /**
+     * @brief Combine two values.
+     *
+     * @details
+     * The parameters are described in a different order than they are
+     * declared, and one of them is not declared at all.
+     *
+     * @param right The right operand.
+     * @param left The left operand.
+     * @param other A parameter that is not declared.
+     * @returns The combined value.
+     */
+    int combine(int left, int right) const;
+
+    /**
+     * @brief A method without any parameter description.
+     * @return Nothing in particular.
+     */
+    int undescribed(int value);
+
+    /**
+     * @brief Set a value.
+     * @param value
+     */
+    void set(int value);
+};
+
+/**
+ * @brief A class template with described template parameters.
+ *
+ * @tparam T The type of the value.
+ * @tparam N The number of values.
+ */
+template <typename T, int N>
+class Values
+{
+};
+
+} // namespace check
+
+#endif /* _MUDDOC_CHECK_PARAMS_H_ */
@@ -0,0 +1,75 @@
+#!/bin/sh
+#
+# ++ start-license-description ++
+#
+# Copyright (c) 2026 Stefan Sinnige.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+# ++ end-license-description ++
+#
+
+# Check the sizes of the report of the slowest symbols: the bytes of a scope
+# include those of its members, like the methods of a class, that are
+# output while the scope is generated.
+#
+# Run by 'make check', with MUDDOC set to the muddoc to test.
+
+MUDDOC=${MUDDOC:-./muddoc}
+srcdir=${srcdir:-.}
+report=slowest.report
+output=slowest.xml
+warnings=slowest.warnings
+status=0
+
+if ! "$MUDDOC" --report-slowest 10 --output "$output" \
+        --warning-file "$warnings" --base "$srcdir/check" code.h \
+        > "$report"; then
+    echo "FAIL: muddoc failed on code.h" >&2
+    status=1
+fi
+
+# Compare the bytes of each scope with the sum of its direct members.
+if ! awk '
+    $6 == "namespace" || $6 == "class" { scopes[$7] = $2 }
+    $6 ~ /^(class|constructor|destructor|method)$/ {
+        scope = $7
+        sub(/::[^:]*$/, "", scope)
+        members[scope] += $2
+    }
+    END {
+        if (!("check::Example" in scopes) || members["check::Example"] == 0) {
+            print "FAIL: check::Example and its methods are not reported"
+            exit 1
+        }
+        for (scope in scopes) {
+            if (scopes[scope] <= members[scope]) {
+                print "FAIL: " scope " has " scopes[scope] " bytes, its " \
+                    "members " members[scope]
+                failed = 1
+            }
+        }
+        exit failed
+    }' "$report" >&2; then
+    cat "$report" >&2
+    status=1
+fi
+
+rm -f "$report" "$output" "$warnings"
+exit $status
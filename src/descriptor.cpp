@@ -24,10 +24,14 @@
  * ++ end-license-description ++
  */
 
+#include <algorithm>
+#include <cctype>
 #include <sstream>
 #include <clang-c/Index.h>
 #include <clang/AST/ASTContext.h>
+#include <llvm/Support/TimeProfiler.h>
 #include "descriptor.h"
+#include "stats.h"
 #include "visitor.h"
 #include "utility.h"
 #include "warn_error.h"
@@ -41,26 +45,161 @@ visit(CXCursor cursor, CXCursor parent, CXClientData data) {
     return CXChildVisit_Continue;
 }
 
+/* Serialise the described parameters, to compare the descriptions */
+static std::string
+described(const std::vector<ParamDescriptor>& params)
+{
+    std::string result;
+    for (const auto& param : params) {
+        result += "<param index=\"" + std::to_string(param.index())
+            + "\" name=\"" + param.name() + "\">" + param.description()
+            + "</param>";
+    }
+    return result;
+}
+
+/* Add the described parameters to a fingerprint */
+static Fingerprint&
+fingerprint(Fingerprint& fingerprint, const std::vector<ParamDescriptor>& params)
+{
+    for (const auto& param : params) {
+        fingerprint.add(static_cast<uint64_t>(param.index()))
+                   .add(param.name())
+                   .add(param.description());
+    }
+    return fingerprint;
+}
+
+/* Resolve the index of a parameter by its name, like clang does for the
+ * param command, or unsigned(-1) if it is not a parameter */
+static unsigned
+resolve(const clang::FunctionDecl* decl, const std::string& name)
+{
+    for (unsigned index = 0; index != decl->getNumParams(); ++index) {
+        const clang::IdentifierInfo* identifier =
+            decl->getParamDecl(index)->getIdentifier();
+        if (identifier != nullptr && identifier->getName() == name) {
+            return index;
+        }
+    }
+    return unsigned(-1);
+}
+
 /* ========================================================================
  * Descriptor
  * ======================================================================== */
 
 Descriptor::Descriptor(const CXCursor& cursor, const clang::Decl* decl)
-    : _decl(decl), _cursor(cursor), _description(&_detailed)
+    : _hash(0), _decl(decl), _cursor(cursor), _description(&_detailed),
+      _references(false)
 {
 }
 
+Descriptor::Comments Descriptor::_comments = Descriptor::Parsed;
+bool Descriptor::_lint = false;
+bool Descriptor::_fingerprints = false;
+
 void
 Descriptor::traverse()
 {
-    const clang::comments::FullComment* fc =
-        _decl->getASTContext().getLocalCommentForDeclUncached(_decl);
+    switch (_comments) {
+        case Parsed:
+            parse();
+            break;
+        case Scanned:
+            if (!scan()) {
+                parse();
+            }
+            break;
+        case Compared: {
+            /* The scanned descriptions are only compared, so their warnings
+             * are dropped. */
+            Diagnostics& collector = diagnostics();
+            Diagnostics dropped;
+            dropped.threshold(Diagnostics::Error);
+            diagnostics(&dropped);
+            bool scanned = scan();
+            diagnostics(&collector);
+            std::string expected;
+            if (scanned) {
+                expected = dump();
+                reset();
+            }
+            parse();
+            std::string actual = dump();
+            if (scanned && actual != expected) {
+                size_t at = std::mismatch(actual.begin(), actual.end(),
+                        expected.begin(), expected.end()).first
+                        - actual.begin();
+                warn("fast-comment", _cursor,
+                        "Scanned comment differs from the parsed comment: \""
+                        + expected.substr(at, 40) + "\" instead of \""
+                        + actual.substr(at, 40) + "\".");
+            }
+            break;
+        }
+    }
+}
+
+void
+Descriptor::parse()
+{
+    const clang::comments::FullComment* fc = nullptr;
+    {
+        Stats::Timer timer(Stats::Comments);
+        fc = _decl->getASTContext().getLocalCommentForDeclUncached(_decl);
+    }
     if (fc != nullptr) {
+        Stats::count(Stats::CommentsParsed);
+        Stats::Timer timer(Stats::Render);
+        llvm::TimeTraceScope trace("Render", [this]() {
+            auto named = llvm::dyn_cast<clang::NamedDecl>(_decl);
+            return named != nullptr ? named->getQualifiedNameAsString() : "";
+        });
         _detailed = traverse(fc);
     }
     else {
-        warn(_cursor, "No comment for declaration.");
+        warn("missing-comment", _cursor, "No comment for declaration.");
+    }
+}
+
+bool
+Descriptor::scan()
+{
+    CommentScanner scanner;
+    const clang::RawComment* raw = nullptr;
+    {
+        Stats::Timer timer(Stats::Comments);
+        clang::ASTContext& context = _decl->getASTContext();
+        raw = context.getRawCommentForDeclNoCache(_decl);
+        if (raw != nullptr) {
+            /* Only a single block comment can be scanned. */
+            if (raw->getKind() != clang::RawComment::RCK_JavaDoc
+                    && raw->getKind() != clang::RawComment::RCK_Qt) {
+                return false;
+            }
+
+            /* The text points straight into the buffer of the source file. */
+            llvm::StringRef text = raw->getRawText(context.getSourceManager());
+            if (!scanner.scan(text.begin(), text.end())) {
+                return false;
+            }
+        }
+    }
+    if (raw == nullptr) {
+        warn("missing-comment", _cursor, "No comment for declaration.");
+        return true;
     }
+    Stats::count(Stats::CommentsScanned);
+    Stats::Timer timer(Stats::Render);
+    llvm::TimeTraceScope trace("Render", [this]() {
+        auto named = llvm::dyn_cast<clang::NamedDecl>(_decl);
+        return named != nullptr ? named->getQualifiedNameAsString() : "";
+    });
+    for (const auto& block : scanner.blocks()) {
+        _detailed += traverse(block);
+    }
+    return true;
 }
 
 std::string
@@ -103,6 +242,15 @@ Descriptor::traverse(const clang::comments::BlockCommandComment* comment)
             result += traverse(comment->child_begin(), comment->child_end());
             result += "</verbatim>";
             break;
+        case clang::comments::CommandTraits::KCI_sa:
+        case clang::comments::CommandTraits::KCI_see:
+        case clang::comments::CommandTraits::KCI_seealso:
+            _references = true;
+            result += "<see>";
+            result += traverse(comment->child_begin(), comment->child_end());
+            result += "</see>";
+            _references = false;
+            break;
         case clang::comments::CommandTraits::KCI_endcode:
         case clang::comments::CommandTraits::KCI_concept:
         case clang::comments::CommandTraits::KCI_cond:
@@ -233,13 +381,10 @@ Descriptor::traverse(const clang::comments::BlockCommandComment* comment)
         case clang::comments::CommandTraits::KCI_rtfinclude:
         case clang::comments::CommandTraits::KCI_rtfonly:
         case clang::comments::CommandTraits::KCI_endrtfonly:
-        case clang::comments::CommandTraits::KCI_sa:
         case clang::comments::CommandTraits::KCI_secreflist:
         case clang::comments::CommandTraits::KCI_endsecreflist:
         case clang::comments::CommandTraits::KCI_section:
         case clang::comments::CommandTraits::KCI_security:
-        case clang::comments::CommandTraits::KCI_see:
-        case clang::comments::CommandTraits::KCI_seealso:
         case clang::comments::CommandTraits::KCI_short:
         case clang::comments::CommandTraits::KCI_showinitializer:
         case clang::comments::CommandTraits::KCI_showrefby:
@@ -313,7 +458,28 @@ Descriptor::traverse(const clang::comments::InlineCommandComment* comment)
     if (comment == nullptr) {
         return std::string();
     }
-    return std::string();
+
+    /* A reference to another symbol. */
+    std::string arg;
+    if (comment->getNumArgs() > 0) {
+        arg = str(comment->getArgText(0));
+    }
+    if (comment->getCommandID() == clang::comments::CommandTraits::KCI_ref) {
+        return reference(arg, arg);
+    }
+
+    /* Otherwise, render the argument as requested by the command. */
+    switch (comment->getRenderKind()) {
+        case clang::comments::InlineCommandComment::RenderMonospaced:
+            return "<code>" + render(arg) + "</code>";
+        case clang::comments::InlineCommandComment::RenderBold:
+            return "<bold>" + render(arg) + "</bold>";
+        case clang::comments::InlineCommandComment::RenderEmphasized:
+            return "<emphasis>" + render(arg) + "</emphasis>";
+        default:
+            break;
+    }
+    return render(arg);
 }
 
 std::string
@@ -356,7 +522,10 @@ Descriptor::traverse(const clang::comments::TextComment* comment)
     if (comment->isWhitespace()) {
         return std::string();
     }
-    return escape(str(comment->getText()));
+    if (_references && !_lint) {
+        return references(str(comment->getText()));
+    }
+    return render(str(comment->getText()));
 }
 
 std::string
@@ -479,11 +648,206 @@ Descriptor::traverse(const clang::comments::Comment::child_iterator begin,
     return result;
 }
 
+std::string
+Descriptor::traverse(const CommentScanner::Block& block)
+{
+    std::string result;
+    switch (block.kind) {
+        case CommentScanner::Block::Paragraph:
+        case CommentScanner::Block::Param:
+        case CommentScanner::Block::TParam:
+            return traverse(block.inlines);
+        case CommentScanner::Block::Brief:
+            _brief = traverse(block.inlines);
+            return std::string();
+        case CommentScanner::Block::See:
+            _references = true;
+            result += "<see>";
+            result += traverse(block.inlines);
+            result += "</see>";
+            _references = false;
+            break;
+        case CommentScanner::Block::Verbatim:
+            result += "<verbatim><![CDATA[";
+            for (const auto& line : block.lines) {
+                result += line + "\n";
+            }
+            result += "]]></verbatim>";
+            break;
+        default:
+            /* Like their clang counterparts, the others are not rendered. */
+            break;
+    }
+    return result;
+}
+
+std::string
+Descriptor::traverse(const std::vector<CommentScanner::Inline>& inlines)
+{
+    std::string result;
+    for (const auto& fragment : inlines) {
+        switch (fragment.kind) {
+            case CommentScanner::Inline::Text:
+                result += _references && !_lint
+                        ? references(fragment.text) : render(fragment.text);
+                break;
+            case CommentScanner::Inline::Code:
+                result += "<code>" + render(fragment.text) + "</code>";
+                break;
+            case CommentScanner::Inline::Bold:
+                result += "<bold>" + render(fragment.text) + "</bold>";
+                break;
+            case CommentScanner::Inline::Emphasis:
+                result += "<emphasis>" + render(fragment.text) + "</emphasis>";
+                break;
+            case CommentScanner::Inline::Reference:
+                result += reference(fragment.text, fragment.text);
+                break;
+        }
+    }
+    return result;
+}
+
+std::string
+Descriptor::dump() const
+{
+    return "<brief>" + _brief + "</brief><detailed>" + _detailed
+        + "</detailed>";
+}
+
+void
+Descriptor::reset()
+{
+    _brief.clear();
+    _detailed.clear();
+}
+
+std::string
+Descriptor::identify() const
+{
+    if (_lint) {
+        return std::string();
+    }
+    Stats::Timer timer(Stats::Usr);
+    return str(clang_getCursorUSR(_cursor));
+}
+
+std::string
+Descriptor::prettify() const
+{
+    if (_lint) {
+        return std::string();
+    }
+    Stats::Timer timer(Stats::Pretty);
+    return str(clang_getCursorPrettyPrinted(_cursor, nullptr));
+}
+
+Fingerprint
+Descriptor::fingerprint() const
+{
+    Fingerprint fingerprint;
+    fingerprint.add(_qualified).add(_usr).add(_brief).add(_detailed);
+    return fingerprint;
+}
+
+std::string
+Descriptor::render(const std::string& text)
+{
+    return _lint ? text : escape(text);
+}
+
+std::string
+Descriptor::reference(const std::string& name, const std::string& text) const
+{
+    std::string scope;
+    const clang::NamedDecl* named = llvm::dyn_cast<clang::NamedDecl>(_decl);
+    if (named != nullptr) {
+        scope = named->getQualifiedNameAsString();
+    }
+    return "<ref name=\"" + escape(name) + "\""
+        + " scope=\"" + escape(scope) + "\">"
+        + escape(text) + "</ref>";
+}
+
+std::string
+Descriptor::references(const std::string& text) const
+{
+    static const char* spaces = " \t";
+    std::string result;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        /* The items of the list are separated by commas or semicolons. */
+        size_t next = text.find_first_of(",;", pos);
+        if (next == std::string::npos) {
+            next = text.size();
+        }
+        std::string item = text.substr(pos, next - pos);
+        size_t start = item.find_first_not_of(spaces);
+        if (start == std::string::npos) {
+            result += escape(item);
+        }
+        else {
+            /* Only the leading word of an item can be a reference: a word on
+             * its own, or one that looks like code when it is followed by
+             * prose, like "Class::method for the details". */
+            size_t end = item.find_first_of(spaces, start);
+            if (end == std::string::npos) {
+                end = item.size();
+            }
+            bool alone = item.find_first_not_of(spaces, end)
+                    == std::string::npos;
+            std::string word = item.substr(start, end - start);
+            result += escape(item.substr(0, start));
+            result += alone || symbolic(word) ? linked(word) : escape(word);
+            result += escape(item.substr(end));
+        }
+        if (next < text.size()) {
+            result += escape(text.substr(next, 1));
+        }
+        pos = next + 1;
+    }
+    return result;
+}
+
+std::string
+Descriptor::linked(const std::string& word) const
+{
+    /* Keep any sentence punctuation out of the reference. */
+    std::string text = word;
+    std::string trail;
+    if (text.size() > 1 && text.back() == '.') {
+        text.pop_back();
+        trail = ".";
+    }
 
-std::ostream&
-operator<<(std::ostream& ostr, const Descriptor& obj)
+    /* Derive the symbol name, allowing for 'name()' and 'Class#name'. */
+    std::string name = text;
+    if (name.size() > 2 && name.compare(name.size() - 2, 2, "()") == 0) {
+        name.erase(name.size() - 2);
+    }
+    for (size_t hash = name.find('#'); hash != std::string::npos;
+            hash = name.find('#', hash)) {
+        name.replace(hash, 1, "::");
+    }
+    unsigned char first = name.empty() ? '\0' : name[0];
+    if (std::isalpha(first) || first == '_' || first == ':'
+            || first == '~') {
+        return reference(name, text) + escape(trail);
+    }
+    return escape(word);
+}
+
+bool
+Descriptor::symbolic(const std::string& word)
 {
-    return ostr;
+    if (word.find("::") != std::string::npos
+            || word.find_first_of("#_~") != std::string::npos
+            || word.find("()") != std::string::npos) {
+        return true;
+    }
+    return std::any_of(word.begin(), word.end(), [](unsigned char c) {
+        return std::isupper(c);
+    });
 }
 
 /* ========================================================================
@@ -501,25 +865,20 @@ NamespaceDescriptor::NamespaceDescriptor(
 void
 NamespaceDescriptor::generate()
 {
+    llvm::TimeTraceScope trace("Namespace", [this]() {
+        return _decl->getQualifiedNameAsString();
+    });
+
     // Capture all descriptive information
     Descriptor::traverse();
     _name = _decl->getNameAsString();
     _qualified = _decl->getQualifiedNameAsString();
-    _members = _visitor.generate(cursor());
-}
-
-std::ostream&
-operator<<(std::ostream& ostr, const NamespaceDescriptor& obj)
-{
-    ostr << "<namespace"
-         << " name=\"" << escape(obj._name) << "\""
-         << " qualified=\"" << escape(obj._qualified) << "\""
-         << ">";
-    ostr << "<brief>" << obj.brief() << "</brief>";
-    ostr << "<detailed>" << obj.detailed() << "</detailed>";
-    ostr << obj._members;
-    ostr << "</namespace>";
-    return ostr;
+    _usr = identify();
+    Fingerprint members;
+    _visitor.generate(*this, _fingerprints ? &members : nullptr);
+    if (_fingerprints) {
+        _hash = fingerprint().add(members.value()).value();
+    }
 }
 
 /* ========================================================================
@@ -537,24 +896,36 @@ ClassDescriptor::ClassDescriptor(
 void
 ClassDescriptor::generate()
 {
+    llvm::TimeTraceScope trace("Class", [this]() {
+        return _decl->getQualifiedNameAsString();
+    });
+
     // Capture all descriptive information
     Descriptor::traverse();
     _name = _decl->getNameAsString();
     _qualified = _decl->getQualifiedNameAsString();
-    _usr = str(clang_getCursorUSR(cursor()));
+    _namespace = scope(_decl, "::");
+    _path = scope(_decl, "/") + _name + "/";
+    _usr = identify();
     _pretty = "class " + _name;
-    _members = _visitor.generate(cursor());
+    Fingerprint members;
+    _visitor.generate(*this, _fingerprints ? &members : nullptr);
+    if (_fingerprints) {
+        Fingerprint hash = fingerprint().add(_pretty);
+        _hash = muddoc::fingerprint(hash, _params).add(members.value()).value();
+    }
 
     // Match the description to the declaration and report any mismatch
     /*
-    if (_params.size() != _decl->param_size()) {
+    if (warnings() && _params.size() != _decl->param_size()) {
         std::stringstream sstr;
         sstr << "Number of template parameters in declaration (" 
              << _decl->param_size() << ") does not match comment ("
              << _params.size() << ").";
-        warn(cursor(), sstr.str());
+        warn("param-count", cursor(), sstr.str());
     }
-    else {
+    else
+    if (warnings()) {
         auto desc_iter = _params.begin();
         auto decl_iter = _decl->param_begin();
         for (;
@@ -569,7 +940,7 @@ ClassDescriptor::generate()
                      << "in declaration does not match "
                      << "parameter \"" << desc_name << "\" "
                      << "in the comment.";
-                warn(cursor(), sstr.str());
+                warn("param-name", cursor(), sstr.str());
             }
         }
     }
@@ -603,7 +974,9 @@ ClassDescriptor::traverse(const clang::comments::TParamCommandComment* comment)
                 description);
     }
     else {
-        std::cout << str(comment->getParamNameAsWritten()) << std::endl;
+        warn("unknown-param", cursor(), "Template parameter \""
+                + str(comment->getParamNameAsWritten())
+                + "\" in the comment is not in the declaration.");
         _params.emplace_back(
                 unsigned(-1),
                 str(comment->getParamNameAsWritten()),
@@ -612,30 +985,37 @@ ClassDescriptor::traverse(const clang::comments::TParamCommandComment* comment)
     return std::string();
 }
 
-std::ostream&
-operator<<(std::ostream& ostr, const ClassDescriptor& obj)
-{
-    ostr << "<class"
-         << " name=\"" << escape(obj._name) << "\""
-         << " qualified=\"" << escape(obj._qualified) << "\""
-         << ">";
-    ostr << "<usr>" << escape(obj._usr) << "</usr>";
-    ostr << "<declaration>" << escape(obj._pretty) << "</declaration>";
-    if (!obj._params.empty()) {
-        ostr << "<parameters>";
-        for (const auto& param: obj._params) {
-            ostr << "<param index=\"" << param.index() << "\">";
-            ostr << "<name>" << escape(param.name()) << "</name>";
-            ostr << "<brief>" << escape(param.description()) << "</brief>";
-            ostr << "</param>";
-        }
-        ostr << "</parameters>";
+std::string
+ClassDescriptor::traverse(const CommentScanner::Block& block)
+{
+    switch (block.kind) {
+        case CommentScanner::Block::TParam:
+            /* A class template is not described, so the position of a
+             * template parameter is never valid. */
+            warn("unknown-param", cursor(), "Template parameter \""
+                    + block.name
+                    + "\" in the comment is not in the declaration.");
+            _params.emplace_back(
+                    unsigned(-1),
+                    block.name,
+                    Descriptor::traverse(block.inlines));
+            return std::string();
+        default:
+            return Descriptor::traverse(block);
     }
-    ostr << "<brief>" << obj.brief() << "</brief>";
-    ostr << "<detailed>" << obj.detailed() << "</detailed>";
-    ostr << obj._members;
-    ostr << "</class>";
-    return ostr;
+}
+
+std::string
+ClassDescriptor::dump() const
+{
+    return Descriptor::dump() + described(_params);
+}
+
+void
+ClassDescriptor::reset()
+{
+    Descriptor::reset();
+    _params.clear();
 }
 
 /* ========================================================================
@@ -655,18 +1035,26 @@ ConstructorDescriptor::generate()
     // Capture all descriptive information
     Descriptor::traverse();
     _name = _decl->getNameAsString();
-    _usr = str(clang_getCursorUSR(cursor()));
-    _pretty = str(clang_getCursorPrettyPrinted(cursor(), nullptr));
+    _qualified = _decl->getQualifiedNameAsString();
+    _namespace = scope(_decl, "::");
+    _path = scope(_decl, "/") + _name;
+    _usr = identify();
+    _pretty = prettify();
+    if (_fingerprints) {
+        Fingerprint hash = fingerprint().add(_pretty);
+        _hash = muddoc::fingerprint(hash, _params).value();
+    }
 
     // Match the description to the declaration and report any mismatch
-    if (_params.size() != _decl->param_size()) {
+    if (warnings() && _params.size() != _decl->param_size()) {
         std::stringstream sstr;
         sstr << "Number of parameters in declaration (" 
              << _decl->param_size() << ") does not match comment ("
              << _params.size() << ").";
-        warn(cursor(), sstr.str());
+        warn("param-count", cursor(), sstr.str());
     }
-    else {
+    else
+    if (warnings()) {
         auto desc_iter = _params.begin();
         auto decl_iter = _decl->param_begin();
         for (;
@@ -681,7 +1069,7 @@ ConstructorDescriptor::generate()
                      << "in declaration does not match "
                      << "parameter \"" << desc_name << "\" "
                      << "in the comment.";
-                warn(cursor(), sstr.str());
+                warn("param-name", cursor(), sstr.str());
             }
         }
     }
@@ -714,7 +1102,9 @@ ConstructorDescriptor::traverse(const clang::comments::ParamCommandComment* comm
                 description);
     }
     else {
-        std::cout << str(comment->getParamNameAsWritten()) << std::endl;
+        warn("unknown-param", cursor(), "Parameter \""
+                + str(comment->getParamNameAsWritten())
+                + "\" in the comment is not in the declaration.");
         _params.emplace_back(
                 unsigned(-1),
                 str(comment->getParamNameAsWritten()),
@@ -723,71 +1113,37 @@ ConstructorDescriptor::traverse(const clang::comments::ParamCommandComment* comm
     return std::string();
 }
 
-std::ostream&
-operator<<(std::ostream& ostr, const ConstructorDescriptor& obj)
-{
-    ostr << "<method"
-         << " name=\"" << escape(obj._name) << "\""
-         << ">";
-    ostr << "<info constructor=\"true\" ";
-    if (obj._decl->isCopyAssignmentOperator())
-        ostr << " copy-assignment=\"true\"";
-    if (obj._decl->isMoveAssignmentOperator())
-        ostr << " move-assignment=\"true\"";
-    if (obj._decl->isOverloadedOperator())
-        ostr << " overloaded-operator=\"true\"";
-    if (obj._decl->isStatic())
-        ostr << " static=\"true\"";
-    if (obj._decl->isConst())
-        ostr << " const=\"true\"";
-    if (obj._decl->isConstexpr())
-        ostr << " const-expr=\"true\"";
-    if (obj._decl->isConsteval())
-        ostr << " const-eval=\"true\"";
-    if (obj._decl->isVirtual())
-        ostr << " virtual=\"true\"";
-    if (obj._decl->isPureVirtual()) 
-        ostr << " pure-virtual=\"true\"";
-    if (obj._decl->isDefaulted())
-        ostr << " default=\"true\"";
-    if (obj._decl->isDeleted())
-        ostr << " delete=\"true\"";
-    if (obj._decl->isVariadic())
-        ostr << " variadic=\"true\"";
-    if (obj._decl->isGlobal())
-        ostr << " global=\"true\"";
-    if (obj._decl->isExternC())
-        ostr << " extern-c=\"true\"";
-    if (obj._decl->isInlined())
-        ostr << " inline=\"true\"";
-    switch (obj._decl->getAccess()) {
-        case clang::AccessSpecifier::AS_private:
-            ostr << " access=\"private\"";
-            break;
-        case clang::AccessSpecifier::AS_protected:
-            ostr << " access=\"protected\"";
-            break;
-        default:
-            ostr << " access=\"public\"";
-            break;
-    }
-    ostr << "/>";
-    ostr << "<usr>" << escape(obj._usr) << "</usr>";
-    ostr << "<declaration>" << escape(obj._pretty) << "</declaration>";
-    if (!obj._params.empty()) {
-        ostr << "<parameters>";
-        for (const auto& param: obj._params) {
-            ostr << "<param index=\"" << param.index() << "\">";
-            ostr << "<name>" << escape(param.name()) << "</name>";
-            ostr << "<brief>" << escape(param.description()) << "</brief>";
-            ostr << "</param>";
+std::string
+ConstructorDescriptor::traverse(const CommentScanner::Block& block)
+{
+    switch (block.kind) {
+        case CommentScanner::Block::Param: {
+            std::string description = Descriptor::traverse(block.inlines);
+            unsigned index = resolve(_decl, block.name);
+            if (index == unsigned(-1)) {
+                warn("unknown-param", cursor(), "Parameter \""
+                        + block.name
+                        + "\" in the comment is not in the declaration.");
+            }
+            _params.emplace_back(index, block.name, description);
+            return std::string();
         }
-        ostr << "</parameters>";
+        default:
+            return Descriptor::traverse(block);
     }
-    ostr << "<brief>" << obj.brief() << "</brief>";
-    ostr << "<detailed>" << obj.detailed() << "</detailed>";
-    ostr << "</method>";
-    return ostr;
+}
+
+std::string
+ConstructorDescriptor::dump() const
+{
+    return Descriptor::dump() + described(_params);
+}
+
+void
+ConstructorDescriptor::reset()
+{
+    Descriptor::reset();
+    _params.clear();
 }
 
 /* ========================================================================
@@ -807,18 +1163,26 @@ DestructorDescriptor::generate()
     // Capture all descriptive information
     Descriptor::traverse();
     _name = _decl->getNameAsString();
-    _usr = str(clang_getCursorUSR(cursor()));
-    _pretty = str(clang_getCursorPrettyPrinted(cursor(), nullptr));
+    _qualified = _decl->getQualifiedNameAsString();
+    _namespace = scope(_decl, "::");
+    _path = scope(_decl, "/") + _name;
+    _usr = identify();
+    _pretty = prettify();
+    if (_fingerprints) {
+        Fingerprint hash = fingerprint().add(_pretty);
+        _hash = muddoc::fingerprint(hash, _params).value();
+    }
 
     // Match the description to the declaration and report any mismatch
-    if (_params.size() != _decl->param_size()) {
+    if (warnings() && _params.size() != _decl->param_size()) {
         std::stringstream sstr;
         sstr << "Number of parameters in declaration (" 
              << _decl->param_size() << ") does not match comment ("
              << _params.size() << ").";
-        warn(cursor(), sstr.str());
+        warn("param-count", cursor(), sstr.str());
     }
-    else {
+    else
+    if (warnings()) {
         auto desc_iter = _params.begin();
         auto decl_iter = _decl->param_begin();
         for (;
@@ -833,7 +1197,7 @@ DestructorDescriptor::generate()
                      << "in declaration does not match "
                      << "parameter \"" << desc_name << "\" "
                      << "in the comment.";
-                warn(cursor(), sstr.str());
+                warn("param-name", cursor(), sstr.str());
             }
         }
     }
@@ -866,7 +1230,9 @@ DestructorDescriptor::traverse(const clang::comments::ParamCommandComment* comme
                 description);
     }
     else {
-        std::cout << str(comment->getParamNameAsWritten()) << std::endl;
+        warn("unknown-param", cursor(), "Parameter \""
+                + str(comment->getParamNameAsWritten())
+                + "\" in the comment is not in the declaration.");
         _params.emplace_back(
                 unsigned(-1),
                 str(comment->getParamNameAsWritten()),
@@ -875,71 +1241,37 @@ DestructorDescriptor::traverse(const clang::comments::ParamCommandComment* comme
     return std::string();
 }
 
-std::ostream&
-operator<<(std::ostream& ostr, const DestructorDescriptor& obj)
-{
-    ostr << "<method"
-         << " name=\"" << escape(obj._name) << "\""
-         << ">";
-    ostr << "<info destructor=\"true\" ";
-    if (obj._decl->isCopyAssignmentOperator())
-        ostr << " copy-assignment=\"true\"";
-    if (obj._decl->isMoveAssignmentOperator())
-        ostr << " move-assignment=\"true\"";
-    if (obj._decl->isOverloadedOperator())
-        ostr << " overloaded-operator=\"true\"";
-    if (obj._decl->isStatic())
-        ostr << " static=\"true\"";
-    if (obj._decl->isConst())
-        ostr << " const=\"true\"";
-    if (obj._decl->isConstexpr())
-        ostr << " const-expr=\"true\"";
-    if (obj._decl->isConsteval())
-        ostr << " const-eval=\"true\"";
-    if (obj._decl->isVirtual())
-        ostr << " virtual=\"true\"";
-    if (obj._decl->isPureVirtual()) 
-        ostr << " pure-virtual=\"true\"";
-    if (obj._decl->isDefaulted())
-        ostr << " default=\"true\"";
-    if (obj._decl->isDeleted())
-        ostr << " delete=\"true\"";
-    if (obj._decl->isVariadic())
-        ostr << " variadic=\"true\"";
-    if (obj._decl->isGlobal())
-        ostr << " global=\"true\"";
-    if (obj._decl->isExternC())
-        ostr << " extern-c=\"true\"";
-    if (obj._decl->isInlined())
-        ostr << " inline=\"true\"";
-    switch (obj._decl->getAccess()) {
-        case clang::AccessSpecifier::AS_private:
-            ostr << " access=\"private\"";
-            break;
-        case clang::AccessSpecifier::AS_protected:
-            ostr << " access=\"protected\"";
-            break;
-        default:
-            ostr << " access=\"public\"";
-            break;
-    }
-    ostr << "/>";
-    ostr << "<usr>" << escape(obj._usr) << "</usr>";
-    ostr << "<declaration>" << escape(obj._pretty) << "</declaration>";
-    if (!obj._params.empty()) {
-        ostr << "<parameters>";
-        for (const auto& param: obj._params) {
-            ostr << "<param index=\"" << param.index() << "\">";
-            ostr << "<name>" << escape(param.name()) << "</name>";
-            ostr << "<brief>" << escape(param.description()) << "</brief>";
-            ostr << "</param>";
+std::string
+DestructorDescriptor::traverse(const CommentScanner::Block& block)
+{
+    switch (block.kind) {
+        case CommentScanner::Block::Param: {
+            std::string description = Descriptor::traverse(block.inlines);
+            unsigned index = resolve(_decl, block.name);
+            if (index == unsigned(-1)) {
+                warn("unknown-param", cursor(), "Parameter \""
+                        + block.name
+                        + "\" in the comment is not in the declaration.");
+            }
+            _params.emplace_back(index, block.name, description);
+            return std::string();
         }
-        ostr << "</parameters>";
+        default:
+            return Descriptor::traverse(block);
     }
-    ostr << "<brief>" << obj.brief() << "</brief>";
-    ostr << "<detailed>" << obj.detailed() << "</detailed>";
-    ostr << "</method>";
-    return ostr;
+}
+
+std::string
+DestructorDescriptor::dump() const
+{
+    return Descriptor::dump() + described(_params);
+}
+
+void
+DestructorDescriptor::reset()
+{
+    Descriptor::reset();
+    _params.clear();
 }
 
 /* ========================================================================
@@ -959,18 +1291,26 @@ MethodDescriptor::generate()
     // Capture all descriptive information
     Descriptor::traverse();
     _name = _decl->getNameAsString();
-    _usr = str(clang_getCursorUSR(cursor()));
-    _pretty = str(clang_getCursorPrettyPrinted(cursor(), nullptr));
+    _qualified = _decl->getQualifiedNameAsString();
+    _namespace = scope(_decl, "::");
+    _path = scope(_decl, "/") + _name;
+    _usr = identify();
+    _pretty = prettify();
+    if (_fingerprints) {
+        Fingerprint hash = fingerprint().add(_pretty);
+        _hash = muddoc::fingerprint(hash, _params).value();
+    }
 
     // Match the description to the declaration and report any mismatch
-    if (_params.size() != _decl->param_size()) {
+    if (warnings() && _params.size() != _decl->param_size()) {
         std::stringstream sstr;
         sstr << "Number of parameters in declaration (" 
              << _decl->param_size() << ") does not match comment ("
              << _params.size() << ").";
-        warn(cursor(), sstr.str());
+        warn("param-count", cursor(), sstr.str());
     }
-    else {
+    else
+    if (warnings()) {
         auto desc_iter = _params.begin();
         auto decl_iter = _decl->param_begin();
         for (;
@@ -985,7 +1325,7 @@ MethodDescriptor::generate()
                      << "in declaration does not match "
                      << "parameter \"" << desc_name << "\" "
                      << "in the comment.";
-                warn(cursor(), sstr.str());
+                warn("param-name", cursor(), sstr.str());
             }
         }
     }
@@ -993,7 +1333,8 @@ MethodDescriptor::generate()
     // Match the description of the return value
     auto type = _decl->getReturnType().getTypePtr();
     if (type && !type->isVoidType() && _return.empty()) {
-        warn(cursor(), "Method has a non-void return type, but no return comment");
+        warn("missing-return", cursor(),
+                "Method has a non-void return type, but no return comment");
     }
 }
 
@@ -1028,7 +1369,9 @@ MethodDescriptor::traverse(const clang::comments::ParamCommandComment* comment)
                 description);
     }
     else {
-        std::cout << str(comment->getParamNameAsWritten()) << std::endl;
+        warn("unknown-param", cursor(), "Parameter \""
+                + str(comment->getParamNameAsWritten())
+                + "\" in the comment is not in the declaration.");
         _params.emplace_back(
                 unsigned(-1),
                 str(comment->getParamNameAsWritten()),
@@ -1037,74 +1380,42 @@ MethodDescriptor::traverse(const clang::comments::ParamCommandComment* comment)
     return std::string();
 }
 
-std::ostream&
-operator<<(std::ostream& ostr, const MethodDescriptor& obj)
-{
-    ostr << "<method"
-         << " name=\"" << escape(obj._name) << "\""
-         << ">";
-    ostr << "<info";
-    if (obj._decl->isCopyAssignmentOperator())
-        ostr << " copy-assignment=\"true\"";
-    if (obj._decl->isMoveAssignmentOperator())
-        ostr << " move-assignment=\"true\"";
-    if (obj._decl->isOverloadedOperator())
-        ostr << " overloaded-operator=\"true\"";
-    if (obj._decl->isStatic())
-        ostr << " static=\"true\"";
-    if (obj._decl->isConst())
-        ostr << " const=\"true\"";
-    if (obj._decl->isConstexpr())
-        ostr << " const-expr=\"true\"";
-    if (obj._decl->isConsteval())
-        ostr << " const-eval=\"true\"";
-    if (obj._decl->isVirtual())
-        ostr << " virtual=\"true\"";
-    if (obj._decl->isPureVirtual()) 
-        ostr << " pure-virtual=\"true\"";
-    if (obj._decl->isDefaulted())
-        ostr << " default=\"true\"";
-    if (obj._decl->isDeleted())
-        ostr << " delete=\"true\"";
-    if (obj._decl->isVariadic())
-        ostr << " variadic=\"true\"";
-    if (obj._decl->isGlobal())
-        ostr << " global=\"true\"";
-    if (obj._decl->isExternC())
-        ostr << " extern-c=\"true\"";
-    if (obj._decl->isInlined())
-        ostr << " inline=\"true\"";
-    switch (obj._decl->getAccess()) {
-        case clang::AccessSpecifier::AS_private:
-            ostr << " access=\"private\"";
-            break;
-        case clang::AccessSpecifier::AS_protected:
-            ostr << " access=\"protected\"";
-            break;
-        default:
-            ostr << " access=\"public\"";
-            break;
-    }
-    ostr << "/>";
-    ostr << "<usr>" << escape(obj._usr) << "</usr>";
-    ostr << "<declaration>" << escape(obj._pretty) << "</declaration>";
-    if (!obj._params.empty()) {
-        ostr << "<parameters>";
-        for (const auto& param: obj._params) {
-            ostr << "<param index=\"" << param.index() << "\">";
-            ostr << "<name>" << escape(param.name()) << "</name>";
-            ostr << "<brief>" << escape(param.description()) << "</brief>";
-            ostr << "</param>";
+std::string
+MethodDescriptor::traverse(const CommentScanner::Block& block)
+{
+    switch (block.kind) {
+        case CommentScanner::Block::Return:
+            _return = Descriptor::traverse(block.inlines);
+            return std::string();
+        case CommentScanner::Block::Param: {
+            std::string description = Descriptor::traverse(block.inlines);
+            unsigned index = resolve(_decl, block.name);
+            if (index == unsigned(-1)) {
+                warn("unknown-param", cursor(), "Parameter \""
+                        + block.name
+                        + "\" in the comment is not in the declaration.");
+            }
+            _params.emplace_back(index, block.name, description);
+            return std::string();
         }
-        ostr << "</parameters>";
-    }
-    if (!obj._return.empty()) {
-        ostr << "<return>" << obj._return << "</return>";
+        default:
+            return Descriptor::traverse(block);
     }
-    ostr << "<brief>" << obj.brief() << "</brief>";
-    ostr << "<detailed>" << obj.detailed() << "</detailed>";
-    ostr << "</method>";
-    return ostr;
+}
+
+std::string
+MethodDescriptor::dump() const
+{
+    return Descriptor::dump() + described(_params)
+        + "<return>" + _return + "</return>";
+}
+
+void
+MethodDescriptor::reset()
+{
+    Descriptor::reset();
+    _params.clear();
+    _return.clear();
 }
 
 /* ========================================================================
@@ -1125,19 +1436,13 @@ EnumDescriptor::generate()
     // Capture all descriptive information
     Descriptor::traverse();
     _name = _decl->getNameAsString();
-    _members = _visitor.generate(cursor());
-}
-
-std::ostream&
-operator<<(std::ostream& ostr, const EnumDescriptor& obj)
-{
-    ostr << "<enum"
-         << " name=\"" << escape(obj._name) << "\">";
-    ostr << "<brief>" << obj.brief() << "</brief>";
-    ostr << "<detailed>" << obj.detailed() << "</detailed>";
-    ostr << "<values>" << obj._members << "</values>";
-    ostr << "</enum>";
-    return ostr;
+    _qualified = _decl->getQualifiedNameAsString();
+    _usr = identify();
+    Fingerprint members;
+    _visitor.generate(*this, _fingerprints ? &members : nullptr);
+    if (_fingerprints) {
+        _hash = fingerprint().add(members.value()).value();
+    }
 }
 
 /* ========================================================================
@@ -1157,17 +1462,11 @@ EnumConstantDescriptor::generate()
     // Capture all descriptive information
     Descriptor::traverse();
     _name = _decl->getNameAsString();
-}
-
-std::ostream&
-operator<<(std::ostream& ostr, const EnumConstantDescriptor& obj)
-{
-    ostr << "<value"
-         << " name=\"" << escape(obj._name) << "\">";
-    ostr << "<brief>" << obj.brief() << "</brief>";
-    ostr << "<detailed>" << obj.detailed() << "</detailed>";
-    ostr << "</value>";
-    return ostr;
+    _qualified = _decl->getQualifiedNameAsString();
+    _usr = identify();
+    if (_fingerprints) {
+        _hash = fingerprint().value();
+    }
 }
 
 } // namespace muddoc
@@ -27,8 +27,11 @@
 #ifndef _MUDDOC_DESC_H_
 #define _MUDDOC_DESC_H_
 
+#include <deque>
 #include <iostream>
+#include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <clang/AST/Decl.h>
 #include <clang/AST/DeclCXX.h>
@@ -36,11 +39,14 @@
 #include <clang-c/CXString.h>
 #include <clang/AST/Comment.h>
 #include <llvm/ADT/StringRef.h>
+#include "fingerprint.h"
+#include "scanner.h"
 
 namespace muddoc {
 
 /** Forward declaration */
 class Visitor;
+class ClassDescriptor;
 
 /**
  * @brief Class to contain description information of a parameter.
@@ -75,8 +81,8 @@ public:
     const std::string& name() const { return _name; }
 
     /**
-     * @brief Return the description.
-     * @return The parameter description.
+     * @brief Return the description as XML.
+     * @return The parameter description, rendered like the brief description.
      */
     const std::string& description() const { return _description; }
 
@@ -115,11 +121,50 @@ private:
 class Descriptor
 {
 public:
+    /**
+     * @brief The source of the comment descriptions.
+     */
+    enum Comments {
+        Parsed,     /**< Parsed by clang into its comment AST */
+        Scanned,    /**< Scanned from the raw comment text, when supported */
+        Compared    /**< Parsed, and compared with the scanned descriptions */
+    };
+
     /**
      * Destructor.
      */
     virtual ~Descriptor() = default;
 
+    /**
+     * @brief Set the source of the comment descriptions.
+     *
+     * @details
+     * Scanning the raw comment text avoids the comment parser and semantic
+     * analysis of clang, but only supports a subset of doxygen. Comments
+     * outside the subset are still parsed by clang. Comparing the two is a
+     * check of the scanner: a warning is generated for every declaration of
+     * which the scanned descriptions are different.
+     *
+     * This has to be set before any declaration is described.
+     *
+     * @param comments The source of the comment descriptions.
+     */
+    static void comments(Comments comments) { _comments = comments; }
+
+    /**
+     * @brief Only describe the declarations to validate their comments.
+     *
+     * @details
+     * The descriptions are still gathered and validated, but the comment
+     * text is not escaped and the declarations are neither pretty-printed
+     * nor identified, as the descriptions are not output.
+     *
+     * This has to be set before any declaration is described.
+     *
+     * @param lint True to only validate the comments.
+     */
+    static void lint(bool lint) { _lint = lint; }
+
     /**
      * @brief Traverse over all the comment descriptions of the declaration.
      *
@@ -149,6 +194,24 @@ public:
      */
     const CXCursor& cursor() const { return _cursor; }
 
+    /**
+     * @brief Get the name of the declaration.
+     * @return The unqualified name of the declaration.
+     */
+    const std::string& name() const { return _name; }
+
+    /**
+     * @brief Get the qualified name of the declaration.
+     * @return The fully qualified name of the declaration.
+     */
+    const std::string& qualified() const { return _qualified; }
+
+    /**
+     * @brief Get the USR of the declaration.
+     * @return The Unified Symbol Resolution of the declaration.
+     */
+    const std::string& usr() const { return _usr; }
+
     /**
      * @brief Get the brief description as XML.
      *
@@ -177,6 +240,40 @@ public:
      */
     const std::string& detailed() const { return _detailed; }
 
+    /**
+     * @brief Get the fingerprint of the description.
+     *
+     * @details
+     * The fingerprint covers the declaration, the descriptions and the
+     * parameters, and that of a namespace, class or enumeration covers the
+     * fingerprints of its members as well. It is only computed when the
+     * fingerprints are enabled.
+     *
+     * @return The hash of the description, or 0 if it is not computed.
+     */
+    uint64_t hash() const { return _hash; }
+
+    /**
+     * @brief Compute a fingerprint of every description.
+     *
+     * @details
+     * The fingerprint is output as a @c hash element after the members of
+     * each declaration, such that a consumer can skip a declaration, or a
+     * whole scope, when its hash did not change.
+     *
+     * This has to be set before any declaration is described.
+     *
+     * @param enable True to compute the fingerprints.
+     */
+    static void fingerprints(bool enable) { _fingerprints = enable; }
+
+    /**
+     * @brief Check whether the fingerprints are computed.
+     *
+     * @return True if the fingerprints are computed.
+     */
+    static bool fingerprints() { return _fingerprints; }
+
 protected:
     /**
      * @brief Create parsed comments for a declaration.
@@ -247,10 +344,131 @@ protected:
             const clang::comments::Comment::child_iterator begin,
             const clang::comments::Comment::child_iterator end);
 
-private:
-    /* Friend class */
-    friend std::ostream& operator<<(std::ostream&, const Descriptor&);
+    /**
+     * @brief Traversal routines for scanned comments.
+     *
+     * @details
+     * The counterparts of the traversal routines of the clang comment
+     * constructs, for the blocks of the raw comment scanner. The default
+     * implementation renders the blocks into exactly the same XML as the
+     * clang comment constructs they correspond to. A derived class that
+     * overrides a clang routine should override this one as well.
+     *
+     * @param block The block encountered.
+     * @return The string representing the description in XML form.
+     */
+    virtual std::string traverse(const CommentScanner::Block& block);
+
+    /**
+     * @brief Render the text of a scanned paragraph.
+     *
+     * @param inlines The text fragments of the paragraph.
+     * @return The string representing the text in XML form.
+     */
+    std::string traverse(const std::vector<CommentScanner::Inline>& inlines);
+
+    /**
+     * @brief Get all comment descriptions in serialised form.
+     *
+     * @details
+     * Used to compare the scanned with the parsed descriptions. A derived
+     * class that keeps descriptions of its own should add them.
+     *
+     * @return The comment descriptions.
+     */
+    virtual std::string dump() const;
+
+    /**
+     * @brief Clear all comment descriptions.
+     *
+     * @details
+     * A derived class that keeps descriptions of its own should clear them
+     * as well.
+     */
+    virtual void reset();
+
+    /**
+     * @brief Generate the USR of the declaration.
+     *
+     * @return The Unified Symbol Resolution of the declaration.
+     */
+    std::string identify() const;
+
+    /**
+     * @brief Pretty-print the declaration.
+     *
+     * @return The declaration in pretty-printed form.
+     */
+    std::string prettify() const;
+
+    /**
+     * @brief Create an unresolved cross-reference.
+     *
+     * @details
+     * A reference to another symbol is output with the scope of this
+     * declaration, such that it can be resolved once all symbols are known.
+     * See @c SymbolIndex for its format.
+     *
+     * @param name The name of the symbol as written in the comment.
+     * @param text The text of the reference.
+     * @return The reference in XML form.
+     */
+    std::string reference(const std::string& name,
+            const std::string& text) const;
+
+    /**
+     * @brief Create cross-references for a list of names.
+     *
+     * @details
+     * The text, for example of a @c see command, is a list of items that are
+     * separated by commas or semicolons. The leading word of an item is
+     * turned into a cross-reference if it is the only word of the item, or
+     * if it looks like code, like "Class::method()" or "Visitor", when it is
+     * followed by prose. All other text is copied as is, such that "the
+     * parser for details" does not refer to anything.
+     *
+     * @param text The text with the names.
+     * @return The text with the references in XML form.
+     */
+    std::string references(const std::string& text) const;
+
+    /**
+     * @brief Create a cross-reference for a single word.
+     *
+     * @param word The word, like "name()" or "Class#name".
+     * @return The reference in XML form, or the escaped word if it is not a
+     * name.
+     */
+    std::string linked(const std::string& word) const;
+
+    /**
+     * @brief Check whether a word looks like code rather than prose.
+     *
+     * @param word The word to check.
+     * @return True if the word is qualified, has a call, an underscore or an
+     * upper case letter.
+     */
+    static bool symbolic(const std::string& word);
+
+    /* The name of the declaration */
+    std::string _name;
+
+    /* The qualified name of the declaration */
+    std::string _qualified;
 
+    /* The USR of the declaration */
+    std::string _usr;
+
+    /* The fingerprint of the description, 0 if not computed */
+    uint64_t _hash;
+
+    /* True to compute the fingerprints */
+    static bool _fingerprints;
+
+    /* Start a fingerprint with the common description */
+    Fingerprint fingerprint() const;
+
+private:
     /* The cursor */
     const CXCursor& _cursor;
 
@@ -265,28 +483,25 @@ private:
 
     /* The description to use (refers to either @c brief or @c detailed) */
     std::string* _description;
-};
 
-/**
- * @brief Output the descriptions of a common declaration in XML.
- *
- * @details
- * Output the brief and detailed section of the declaration. The format will be
- * in XML as:
- *
- * @code
- * <brief>...</brief>
- * <detail>...</detail>
- * @endcode
- *
- * The @c brief section is usually a very short description, while the @c detail
- * section can be quite complex with embedded blocks.
- *
- * @param ostr The stream to output the comments to.
- * @param obj The object to output.
- * @return The @p ostr stream.
- */
-std::ostream& operator<<(std::ostream& ostr, const Descriptor& obj);
+    /* True if the text consists of references, like in a @c see command */
+    bool _references;
+
+    /* The source of the comment descriptions */
+    static Comments _comments;
+
+    /* True to only validate the comments */
+    static bool _lint;
+
+    /* Escape the text of a comment, unless only validating */
+    static std::string render(const std::string& text);
+
+    /* Describe from the comment parsed by clang */
+    void parse();
+
+    /* Describe from the scanned raw comment, false if not supported */
+    bool scan();
+};
 
 /**
  * @brief Descriptor for a namespace declaration.
@@ -326,51 +541,13 @@ public:
     virtual void generate() override;
 
 private:
-    /* Friend class */
-    friend std::ostream& operator<<(std::ostream&, const NamespaceDescriptor&);
-
     /* The declaration */
     const clang::NamespaceDecl* _decl;
 
     /* The visitor object */
     const Visitor& _visitor;
-
-    /* The name of the class */
-    std::string _name;
-
-    /* The qualified name of the class */
-    std::string _qualified;
-
-    /* The XML representation of all its child member constructs */
-    std::string _members;
 };
 
-/**
- * @brief Output the description of a namespace comment in XML.
- *
- * @details
- * Output the brief and detailed section of the comment. The format will be
- * in XML as:
- *
- * @code
- * <namespace name="NAME" qualified="QUALIFIED">
- *   <!-- From the Decl output: -->
- *   <brief/>
- *   <detail/>
- *   MEMBERS
- * </cclass>
- * @endcode
- *
- * The @c brief and @c detail sections are output from the common declaration
- * part but will not contain the comments that has been withheld and be made
- * accessible in different parts of the output.
- *
- * @param ostr The stream to output the comments to.
- * @param obj The object to output.
- * @return The @p ostr stream.
- */
-std::ostream& operator<<(std::ostream& ostr, const NamespaceDescriptor& obj);
-
 /**
  * @brief Descriptor for a class declaration.
  *
@@ -421,66 +598,59 @@ public:
             const clang::comments::BlockCommandComment* comment) override;
     virtual std::string traverse(
             const clang::comments::TParamCommandComment* comment) override;
+    virtual std::string traverse(
+            const CommentScanner::Block& block) override;
 
-private:
-    /* Friend class */
-    friend std::ostream& operator<<(std::ostream&, const ClassDescriptor&);
+    /**
+     * @brief Comment description overrides.
+     */
+    virtual std::string dump() const override;
+    virtual void reset() override;
+
+    /**
+     * @brief Return the enclosing scope.
+     * @return The enclosing namespaces and classes, each followed by '::'.
+     */
+    const std::string& enclosing() const { return _namespace; }
 
+    /**
+     * @brief Return the output path.
+     * @return The output path of the class, separated by '/'.
+     */
+    const std::string& path() const { return _path; }
+
+    /**
+     * @brief Return the declaration.
+     * @return The declaration of the class in pretty-printed form.
+     */
+    const std::string& declaration() const { return _pretty; }
+
+    /**
+     * @brief Return the described template parameters.
+     * @return The template parameters in the order they are described.
+     */
+    const std::vector<ParamDescriptor>& params() const { return _params; }
+
+private:
     /* The declaration */
     const clang::CXXRecordDecl* _decl;
 
     /* The visitor object */
     const Visitor& _visitor;
 
-    /* The name of the class */
-    std::string _name;
-
-    /* The qualified name of the class */
-    std::string _qualified;
+    /* The enclosing namespaces and classes, separated by '::' */
+    std::string _namespace;
 
-    /* The USR of the declaration */
-    std::string _usr;
+    /* The output path of the class, separated by '/' */
+    std::string _path;
 
     /* The declaration in pretty-printed form */
     std::string _pretty;
 
     /* The template parameters */
     std::vector<ParamDescriptor> _params;
-
-    /* The class members in XML serialised form. */
-    std::string _members;
 };
 
-/**
- * @brief Output the description of a class comment in XML.
- *
- * @details
- * Output the brief and detailed section of the comment. The format will be
- * in XML as:
- *
- * @code
- * <class name="NAME" qualified="QUALIFIED">
- *   <usr>USR</usr>
- *   <templte-parameters>
- *     <param>
- *     </param>
- *   </templte-parameters>
- *   <!-- From the Decl output: -->
- *   <brief/>
- *   <detail/>
- * </cclass>
- * @endcode
- *
- * The @c brief and @c detail sections are output from the common declaration
- * part but will not contain the comments that has been withheld and be made
- * accessible in different parts of the output.
- *
- * @param ostr The stream to output the comments to.
- * @param obj The object to output.
- * @return The @p ostr stream.
- */
-std::ostream& operator<<(std::ostream& ostr, const ClassDescriptor& obj);
-
 /**
  * @brief Descriptor for a constructor declaration.
  *
@@ -531,19 +701,54 @@ public:
             const clang::comments::BlockCommandComment* comment) override;
     virtual std::string traverse(
             const clang::comments::ParamCommandComment* comment) override;
+    virtual std::string traverse(
+            const CommentScanner::Block& block) override;
 
-private:
-    /* Friend class */
-    friend std::ostream& operator<<(std::ostream&, const ConstructorDescriptor&);
+    /**
+     * @brief Comment description overrides.
+     */
+    virtual std::string dump() const override;
+    virtual void reset() override;
+
+    /**
+     * @brief Return the declaration.
+     * @return The declaration of the constructor in pretty-printed form.
+     */
+    const std::string& declaration() const { return _pretty; }
+
+    /**
+     * @brief Return the described parameters.
+     * @return The parameters in the order they are described.
+     */
+    const std::vector<ParamDescriptor>& params() const { return _params; }
 
+    /**
+     * @brief Return the enclosing scope.
+     * @return The enclosing namespaces and classes, each followed by '::'.
+     */
+    const std::string& enclosing() const { return _namespace; }
+
+    /**
+     * @brief Return the output path.
+     * @return The output path of the constructor, separated by '/'.
+     */
+    const std::string& path() const { return _path; }
+
+    /**
+     * @brief Return the clang declaration.
+     * @return The constructor declaration, for its properties like @c virtual.
+     */
+    const clang::CXXConstructorDecl* decl() const { return _decl; }
+
+private:
     /* The declaration */
     const clang::CXXConstructorDecl* _decl;
 
-    /* The name of the method */
-    std::string _name;
+    /* The enclosing namespaces and classes, separated by '::' */
+    std::string _namespace;
 
-    /* The USR of the declaration */
-    std::string _usr;
+    /* The output path of the method, separated by '/' */
+    std::string _path;
 
     /* The declaration in pretty-printed form */
     std::string _pretty;
@@ -552,38 +757,6 @@ private:
     std::vector<ParamDescriptor> _params;
 };
 
-/**
- * @brief Output the description of a constructor comment in XML.
- *
- * @details
- * Output the brief and detailed section of the comment. The format will be
- * in XML as:
- *
- * @code
- * <constructor name="NAME">
- *   <info constructor="true" key=value/>
- *   <usr>USR</usr>
- *   <declaration>DECL</declaration>
- *   <parameters>
- *     <param>
- *     </param>
- *   </parameters>
- *   <!-- From the Decl output: -->
- *   <brief/>
- *   <detail/>
- * </constructor>
- * @endcode
- *
- * The @c brief and @c detail sections are output from the common declaration
- * part but will not contain the comments that has been withheld and be made
- * accessible in different parts of the output.
- *
- * @param ostr The stream to output the comments to.
- * @param obj The object to output.
- * @return The @p ostr stream.
- */
-std::ostream& operator<<(std::ostream& ostr, const ConstructorDescriptor& obj);
-
 /**
  * @brief Descriptor for a destructor declaration.
  *
@@ -634,19 +807,54 @@ public:
             const clang::comments::BlockCommandComment* comment) override;
     virtual std::string traverse(
             const clang::comments::ParamCommandComment* comment) override;
+    virtual std::string traverse(
+            const CommentScanner::Block& block) override;
 
-private:
-    /* Friend class */
-    friend std::ostream& operator<<(std::ostream&, const DestructorDescriptor&);
+    /**
+     * @brief Comment description overrides.
+     */
+    virtual std::string dump() const override;
+    virtual void reset() override;
+
+    /**
+     * @brief Return the declaration.
+     * @return The declaration of the destructor in pretty-printed form.
+     */
+    const std::string& declaration() const { return _pretty; }
+
+    /**
+     * @brief Return the described parameters.
+     * @return The parameters in the order they are described.
+     */
+    const std::vector<ParamDescriptor>& params() const { return _params; }
 
+    /**
+     * @brief Return the enclosing scope.
+     * @return The enclosing namespaces and classes, each followed by '::'.
+     */
+    const std::string& enclosing() const { return _namespace; }
+
+    /**
+     * @brief Return the output path.
+     * @return The output path of the destructor, separated by '/'.
+     */
+    const std::string& path() const { return _path; }
+
+    /**
+     * @brief Return the clang declaration.
+     * @return The destructor declaration, for its properties like @c virtual.
+     */
+    const clang::CXXDestructorDecl* decl() const { return _decl; }
+
+private:
     /* The declaration */
     const clang::CXXDestructorDecl* _decl;
 
-    /* The name of the method */
-    std::string _name;
+    /* The enclosing namespaces and classes, separated by '::' */
+    std::string _namespace;
 
-    /* The USR of the declaration */
-    std::string _usr;
+    /* The output path of the method, separated by '/' */
+    std::string _path;
 
     /* The declaration in pretty-printed form */
     std::string _pretty;
@@ -655,38 +863,6 @@ private:
     std::vector<ParamDescriptor> _params;
 };
 
-/**
- * @brief Output the description of a destructor comment in XML.
- *
- * @details
- * Output the brief and detailed section of the comment. The format will be
- * in XML as:
- *
- * @code
- * <method name="NAME">
- *   <info destructor="true" key=value/>
- *   <usr>USR</usr>
- *   <declaration>DECL</declaration>
- *   <parameters>
- *     <param>
- *     </param>
- *   </parameters>
- *   <!-- From the Decl output: -->
- *   <brief/>
- *   <detail/>
- * </method>
- * @endcode
- *
- * The @c brief and @c detail sections are output from the common declaration
- * part but will not contain the comments that has been withheld and be made
- * accessible in different parts of the output.
- *
- * @param ostr The stream to output the comments to.
- * @param obj The object to output.
- * @return The @p ostr stream.
- */
-std::ostream& operator<<(std::ostream& ostr, const DestructorDescriptor& obj);
-
 /**
  * @brief Descriptor for a method declaration.
  *
@@ -735,19 +911,60 @@ public:
             const clang::comments::BlockCommandComment* comment) override;
     virtual std::string traverse(
             const clang::comments::ParamCommandComment* comment) override;
+    virtual std::string traverse(
+            const CommentScanner::Block& block) override;
 
-private:
-    /* Friend class */
-    friend std::ostream& operator<<(std::ostream&, const MethodDescriptor&);
+    /**
+     * @brief Comment description overrides.
+     */
+    virtual std::string dump() const override;
+    virtual void reset() override;
+
+    /**
+     * @brief Return the declaration.
+     * @return The declaration of the method in pretty-printed form.
+     */
+    const std::string& declaration() const { return _pretty; }
+
+    /**
+     * @brief Return the described parameters.
+     * @return The parameters in the order they are described.
+     */
+    const std::vector<ParamDescriptor>& params() const { return _params; }
+
+    /**
+     * @brief Return the enclosing scope.
+     * @return The enclosing namespaces and classes, each followed by '::'.
+     */
+    const std::string& enclosing() const { return _namespace; }
+
+    /**
+     * @brief Return the output path.
+     * @return The output path of the method, separated by '/'.
+     */
+    const std::string& path() const { return _path; }
+
+    /**
+     * @brief Return the clang declaration.
+     * @return The method declaration, for its properties like @c virtual.
+     */
+    const clang::CXXMethodDecl* decl() const { return _decl; }
+
+    /**
+     * @brief Return the description of the return value.
+     * @return The description of the return value, or an empty string.
+     */
+    const std::string& returns() const { return _return; }
 
+private:
     /* The declaration */
     const clang::CXXMethodDecl* _decl;
 
-    /* The name of the method */
-    std::string _name;
+    /* The enclosing namespaces and classes, separated by '::' */
+    std::string _namespace;
 
-    /* The USR of the declaration */
-    std::string _usr;
+    /* The output path of the method, separated by '/' */
+    std::string _path;
 
     /* The declaration in pretty-printed form */
     std::string _pretty;
@@ -759,40 +976,6 @@ private:
     std::string _return;
 };
 
-/**
- * @brief Output the description of a method comment in XML.
- *
- * @details
- * Output the brief and detailed section of the comment. The format will be
- * in XML as:
- *
- * @code
- * <method name="NAME">
- *   <info key=value/>
- *   <usr>USR</usr>
- *   <declaration>DECL</declaration>
- *   <parameters>
- *     <param>
- *     </param>
- *   </parameters>
- *   <return>
- *   </return>
- *   <!-- From the Decl output: -->
- *   <brief/>
- *   <detail/>
- * </method>
- * @endcode
- *
- * The @c brief and @c detail sections are output from the common declaration
- * part but will not contain the comments that has been withheld and be made
- * accessible in different parts of the output.
- *
- * @param ostr The stream to output the comments to.
- * @param obj The object to output.
- * @return The @p ostr stream.
- */
-std::ostream& operator<<(std::ostream& ostr, const MethodDescriptor& obj);
-
 /**
  * @brief Descriptor for an enum declaration.
  *
@@ -831,47 +1014,13 @@ public:
     virtual void generate() override;
 
 private:
-    /* Friend class */
-    friend std::ostream& operator<<(std::ostream&, const EnumDescriptor&);
-
     /* The declaration */
     const clang::EnumDecl* _decl;
 
     /* The visitor object */
     const Visitor& _visitor;
-
-    /* The name of the enumeration */
-    std::string _name;
-
-    /* The XML representation of all its child member constructs */
-    std::string _members;
 };
 
-/**
- * @brief Output the description of a method comment in XML.
- *
- * @details
- * Output the brief and detailed section of the comment. The format will be
- * in XML as:
- *
- * @code
- * <enum name="NAME">
- *   MEMBERS
- *   <!-- From the Decl output: -->
- *   <brief/>
- *   <detail/>
- * </method>
- * @endcode
- *
- * The @c brief and @c detail sections are output from the common declaration
- * part. The enumeration members are output inside the enumeration description.
- *
- * @param ostr The stream to output the comments to.
- * @param obj The object to output.
- * @return The @p ostr stream.
- */
-std::ostream& operator<<(std::ostream& ostr, const EnumDescriptor& obj);
-
 /**
  * @brief Descriptor for an enum constant value declaration.
  *
@@ -908,40 +1057,10 @@ public:
     virtual void generate() override;
 
 private:
-    /* Friend class */
-    friend std::ostream& operator<<(std::ostream&, const EnumConstantDescriptor&);
-
     /* The declaration */
     const clang::EnumConstantDecl* _decl;
-
-    /* The name of the enumeration */
-    std::string _name;
 };
 
-/**
- * @brief Output the description of a method comment in XML.
- *
- * @details
- * Output the brief and detailed section of the comment. The format will be
- * in XML as:
- *
- * @code
- * <value name="NAME">
- *   <!-- From the Decl output: -->
- *   <brief/>
- *   <detail/>
- * </value>
- * @endcode
- *
- * The @c brief and @c detail sections are output from the common declaration
- * part. The enumeration members are output inside the enumeration description.
- *
- * @param ostr The stream to output the comments to.
- * @param obj The object to output.
- * @return The @p ostr stream.
- */
-std::ostream& operator<<(std::ostream& ostr, const EnumConstantDescriptor& obj);
-
 } // namespace muddoc
 
 #endif /* _MUDDOC_DESC_H_ */
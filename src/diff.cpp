@@ -0,0 +1,358 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#include <algorithm>
+#include <sstream>
+#include "diff.h"
+#include "utility.h"
+
+namespace muddoc {
+
+/* The names of the kinds of change, in the order of their bits */
+static const char* __changes[] = { "declaration", "documentation", "access" };
+
+struct Differ::Frame
+{
+    /* The description of the symbol so far */
+    Symbol symbol;
+
+    /* The digest of the documentation so far */
+    Fingerprint docs;
+
+    /* True if any documentation has been added to the digest */
+    bool documented = false;
+};
+
+bool
+Differ::load(std::istream& istr, std::string& error)
+{
+    return read(istr, true, error);
+}
+
+bool
+Differ::compare(std::istream& istr, std::string& error)
+{
+    return read(istr, false, error);
+}
+
+bool
+Differ::read(std::istream& istr, bool old, std::string& error)
+{
+    XmlReader reader(istr);
+    std::vector<Frame> open;
+    while (true) {
+        switch (reader.next()) {
+            case XmlReader::StartElement: {
+                const std::string& name = reader.name();
+                if (symbol(name)) {
+                    // Qualify the name by the attributes, or otherwise by the
+                    // enclosing symbol.
+                    const std::string* qualified = reader.attribute("qualified");
+                    const std::string* ns = reader.attribute("namespace");
+                    const std::string* attr = reader.attribute("name");
+                    std::string unqualified = attr != nullptr ? *attr : "";
+                    open.emplace_back();
+                    Symbol& symbol = open.back().symbol;
+                    symbol.kind = name;
+                    if (qualified != nullptr) {
+                        symbol.name = *qualified;
+                    }
+                    else
+                    if (ns != nullptr) {
+                        symbol.name = *ns + unqualified;
+                    }
+                    else
+                    if (open.size() > 1) {
+                        symbol.name = open[open.size() - 2].symbol.name
+                                + "::" + unqualified;
+                    }
+                    else {
+                        symbol.name = unqualified;
+                    }
+                    attr = reader.attribute("usr");
+                    if (attr != nullptr) {
+                        symbol.usr = *attr;
+                    }
+                    break;
+                }
+                if (open.empty()) {
+                    break;
+                }
+
+                // The own elements of a symbol are small, read them whole.
+                Frame& frame = open.back();
+                if (name == "usr" || name == "declaration" || name == "info"
+                        || name == "brief" || name == "detailed"
+                        || name == "parameters" || name == "return")
+                {
+                    auto node = XmlNode::read(reader, error);
+                    if (node == nullptr) {
+                        return false;
+                    }
+                    if (name == "usr") {
+                        frame.symbol.usr = node->content();
+                    }
+                    else
+                    if (name == "declaration") {
+                        frame.symbol.declaration =
+                                node->content() + frame.symbol.declaration;
+                    }
+                    else
+                    if (name == "info") {
+                        for (const auto& attr: node->attributes()) {
+                            if (attr.first == "access") {
+                                frame.symbol.access = attr.second;
+                            }
+                            else {
+                                frame.symbol.declaration += " [" + attr.first
+                                        + "=" + attr.second + "]";
+                            }
+                        }
+                    }
+                    else {
+                        std::stringstream sstr;
+                        sstr << *node;
+                        frame.docs.add(name).add(sstr.str());
+                        frame.documented = true;
+                    }
+                }
+                break; }
+            case XmlReader::EndElement:
+                if (symbol(reader.name()) && !open.empty()) {
+                    Frame& frame = open.back();
+                    if (frame.documented) {
+                        frame.symbol.docs = frame.docs.value();
+                    }
+                    if (old) {
+                        add(frame.symbol, _old, _index);
+                    }
+                    else {
+                        add(frame.symbol, _new, _current);
+                    }
+                    open.pop_back();
+                }
+                break;
+            case XmlReader::Text:
+            case XmlReader::CData:
+                break;
+            case XmlReader::EndDocument:
+                if (!old) {
+                    compare();
+                }
+                return true;
+            case XmlReader::Error:
+                error = reader.error();
+                return false;
+        }
+    }
+}
+
+void
+Differ::add(Symbol& symbol, std::vector<Symbol>& symbols,
+        std::unordered_map<std::string, size_t>& index)
+{
+    if (symbol.usr.empty()) {
+        return;
+    }
+    auto iter = index.emplace(symbol.usr, symbols.size());
+    if (iter.second) {
+        symbols.push_back(std::move(symbol));
+        return;
+    }
+
+    // Fold the documentation of a later appearance, like that of a re-opened
+    // namespace, into the first appearance.
+    Symbol& first = symbols[iter.first->second];
+    if (symbol.docs != 0) {
+        first.docs = first.docs == 0 ? symbol.docs
+                   : Fingerprint().add(first.docs).add(symbol.docs).value();
+    }
+}
+
+void
+Differ::compare()
+{
+    for (auto& symbol: _new) {
+        auto iter = _index.find(symbol.usr);
+        if (iter == _index.end()) {
+            _added.push_back(std::move(symbol));
+            continue;
+        }
+        Symbol& old = _old[iter->second];
+        old.matched = true;
+        unsigned changes = 0;
+        if (old.declaration != symbol.declaration) {
+            changes |= Declaration;
+        }
+        if (old.docs != symbol.docs) {
+            changes |= Documentation;
+        }
+        if (old.access != symbol.access) {
+            changes |= Access;
+        }
+        if (changes != 0) {
+            _changed.push_back(
+                    Changed{ iter->second, std::move(symbol), changes });
+        }
+    }
+    _new.clear();
+    _current.clear();
+}
+
+bool
+Differ::differ() const
+{
+    if (!_added.empty() || !_changed.empty()) {
+        return true;
+    }
+    for (const auto& symbol: _old) {
+        if (!symbol.matched) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+Differ::write(std::ostream& ostr, Format format)
+{
+    // Sort the differences by name, and by USR for overloads.
+    auto less = [](const Symbol& lhs, const Symbol& rhs) {
+        return lhs.name != rhs.name ? lhs.name < rhs.name : lhs.usr < rhs.usr;
+    };
+    std::vector<const Symbol*> removed;
+    for (const auto& symbol: _old) {
+        if (!symbol.matched) {
+            removed.push_back(&symbol);
+        }
+    }
+    std::sort(removed.begin(), removed.end(),
+            [&less](const Symbol* lhs, const Symbol* rhs) {
+                return less(*lhs, *rhs);
+            });
+    std::sort(_added.begin(), _added.end(), less);
+    std::sort(_changed.begin(), _changed.end(),
+            [&less](const Changed& lhs, const Changed& rhs) {
+                return less(lhs.symbol, rhs.symbol);
+            });
+
+    if (format == Text) {
+        for (const auto& symbol: _added) {
+            ostr << "+ " << symbol.kind << " " << symbol.name << "\n";
+        }
+        for (const auto* symbol: removed) {
+            ostr << "- " << symbol->kind << " " << symbol->name << "\n";
+        }
+        for (const auto& change: _changed) {
+            const Symbol& old = _old[change.old];
+            ostr << "~ " << change.symbol.kind << " " << change.symbol.name
+                 << " (";
+            const char* sep = "";
+            for (size_t i = 0; i < sizeof(__changes) / sizeof(*__changes); ++i) {
+                if (change.changes & (1 << i)) {
+                    ostr << sep << __changes[i];
+                    sep = ", ";
+                }
+            }
+            ostr << ")\n";
+            if (change.changes & Declaration) {
+                ostr << "    old: " << old.declaration << "\n"
+                     << "    new: " << change.symbol.declaration << "\n";
+            }
+            if (change.changes & Access) {
+                ostr << "    old access: " << old.access << "\n"
+                     << "    new access: " << change.symbol.access << "\n";
+            }
+        }
+        return;
+    }
+
+    auto identify = [&ostr](const Symbol& symbol) {
+        ostr << "{\"kind\":" << quote(symbol.kind)
+             << ",\"name\":" << quote(symbol.name)
+             << ",\"usr\":" << quote(symbol.usr);
+    };
+    const char* sep = "";
+    ostr << "{\"added\":[";
+    for (const auto& symbol: _added) {
+        ostr << sep;
+        identify(symbol);
+        ostr << "}";
+        sep = ",";
+    }
+    sep = "";
+    ostr << "],\"removed\":[";
+    for (const auto* symbol: removed) {
+        ostr << sep;
+        identify(*symbol);
+        ostr << "}";
+        sep = ",";
+    }
+    sep = "";
+    ostr << "],\"changed\":[";
+    for (const auto& change: _changed) {
+        const Symbol& old = _old[change.old];
+        ostr << sep;
+        identify(change.symbol);
+        ostr << ",\"changes\":[";
+        const char* comma = "";
+        for (size_t i = 0; i < sizeof(__changes) / sizeof(*__changes); ++i) {
+            if (change.changes & (1 << i)) {
+                ostr << comma << quote(__changes[i]);
+                comma = ",";
+            }
+        }
+        ostr << "],\"old\":{\"declaration\":" << quote(old.declaration)
+             << ",\"access\":" << quote(old.access) << "}"
+             << ",\"new\":{\"declaration\":" << quote(change.symbol.declaration)
+             << ",\"access\":" << quote(change.symbol.access) << "}}";
+        sep = ",";
+    }
+    ostr << "]}\n";
+}
+
+bool
+Differ::parse(const std::string& name, Format& format)
+{
+    if (name == "text") {
+        format = Text;
+        return true;
+    }
+    if (name == "json") {
+        format = Json;
+        return true;
+    }
+    return false;
+}
+
+bool
+Differ::symbol(const std::string& name)
+{
+    return name == "namespace" || name == "class" || name == "method"
+        || name == "enum" || name == "value" || name == "symbol";
+}
+
+} // namespace muddoc
@@ -0,0 +1,224 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#ifndef _MUDDOC_DIFF_H_
+#define _MUDDOC_DIFF_H_
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "fingerprint.h"
+#include "xml.h"
+
+namespace muddoc {
+
+/**
+ * @brief Compare the symbols of two muddoc generated documents.
+ *
+ * @details
+ * The symbols of both documents are matched by their USR, regardless of
+ * where they appear, and reported as added, removed or changed. A symbol is
+ * changed if its:
+ *  * declaration changed, including the flags of its @c info element, like
+ *    @c static or @c virtual;
+ *  * documentation changed, being its brief and detailed descriptions, its
+ *    parameters and its return value;
+ *  * access changed.
+ *
+ * The documents are read as a stream of elements, so neither document is
+ * held in memory as a tree. A summary of each symbol of both documents is
+ * kept, being its names, declaration and access, with only a digest of its
+ * documentation, such that the comparison is linear in the size of the
+ * documents. The symbols of the new document are buffered until it has
+ * been read and are only then compared, because a symbol that appears more
+ * than once in a document, like a re-opened namespace, is compared by the
+ * declaration and access of its first appearance, and by the documentation
+ * of all its appearances together: the digest of each later appearance is
+ * folded into that of the first.
+ */
+class Differ
+{
+public:
+    /**
+     * @brief The output format of the differences.
+     */
+    enum Format { Text, Json };
+
+    /**
+     * @brief Create an empty comparison.
+     */
+    Differ() = default;
+
+    /**
+     * @brief Read the old document.
+     *
+     * @param istr The stream to read the document from.
+     * @param error Set to the error message if the document is malformed.
+     * @return True if the document has been read.
+     */
+    bool load(std::istream& istr, std::string& error);
+
+    /**
+     * @brief Compare the new document with the old document.
+     *
+     * @details
+     * This should be called once, after the old document has been loaded.
+     *
+     * @param istr The stream to read the document from.
+     * @param error Set to the error message if the document is malformed.
+     * @return True if the document has been compared.
+     */
+    bool compare(std::istream& istr, std::string& error);
+
+    /**
+     * @brief Output the differences.
+     *
+     * @details
+     * The symbols are output sorted by their qualified name. In text, each
+     * symbol is a line that starts with '+' if it was added, '-' if it was
+     * removed or '~' if it changed, followed by the changes and the old and
+     * new declaration or access. In JSON the differences are output as:
+     *
+     * @code
+     * {
+     *   "added": [ { "kind": KIND, "name": NAME, "usr": USR }, ... ],
+     *   "removed": [ ... ],
+     *   "changed": [ { "kind": KIND, "name": NAME, "usr": USR,
+     *                  "changes": [ "declaration", "documentation", "access" ],
+     *                  "old": { "declaration": DECL, "access": ACCESS },
+     *                  "new": { "declaration": DECL, "access": ACCESS } },
+     *                ... ]
+     * }
+     * @endcode
+     *
+     * @param ostr The stream to output the differences to.
+     * @param format The output format.
+     */
+    void write(std::ostream& ostr, Format format);
+
+    /**
+     * @brief Check whether the documents differ.
+     *
+     * @return True if any symbol has been added, removed or changed.
+     */
+    bool differ() const;
+
+    /**
+     * @brief Parse the name of a format.
+     *
+     * @param name The name, one of "text" or "json".
+     * @param format Set to the format if the name is valid.
+     * @return True if the name is valid.
+     */
+    static bool parse(const std::string& name, Format& format);
+
+private:
+    /* The kinds of change of a symbol */
+    enum Change {
+        Declaration = 1 << 0,
+        Documentation = 1 << 1,
+        Access = 1 << 2
+    };
+
+    /* The description of a symbol */
+    struct Symbol
+    {
+        /* The element name, like "class" */
+        std::string kind;
+
+        /* The qualified name */
+        std::string name;
+
+        /* The USR */
+        std::string usr;
+
+        /* The declaration, followed by the flags of its info element */
+        std::string declaration;
+
+        /* The access, empty if not a member */
+        std::string access;
+
+        /* The digest of the documentation of all appearances, 0 if none */
+        uint64_t docs = 0;
+
+        /* True if it has been matched by a symbol of the new document */
+        bool matched = false;
+    };
+
+    /* A symbol that changed */
+    struct Changed
+    {
+        /* The symbol in the old document */
+        size_t old;
+
+        /* The symbol in the new document */
+        Symbol symbol;
+
+        /* The kinds of change */
+        unsigned changes;
+    };
+
+    /* An open symbol while reading a document */
+    struct Frame;
+
+    /* Read a document and add or compare each of its symbols */
+    bool read(std::istream& istr, bool old, std::string& error);
+
+    /* Add a symbol, or fold it into an earlier appearance */
+    static void add(Symbol& symbol, std::vector<Symbol>& symbols,
+            std::unordered_map<std::string, size_t>& index);
+
+    /* Compare the symbols of the new document with the old document */
+    void compare();
+
+    /* Return true if the element is a symbol */
+    static bool symbol(const std::string& name);
+
+    /* The symbols of the old document, in order of appearance */
+    std::vector<Symbol> _old;
+
+    /* The index of the symbols of the old document by USR */
+    std::unordered_map<std::string, size_t> _index;
+
+    /* The symbols of the new document, in order of appearance, until it has
+     * been read and compared */
+    std::vector<Symbol> _new;
+
+    /* The index of the symbols of the new document by USR */
+    std::unordered_map<std::string, size_t> _current;
+
+    /* The symbols that have been added */
+    std::vector<Symbol> _added;
+
+    /* The symbols that changed */
+    std::vector<Changed> _changed;
+};
+
+} // namespace muddoc
+
+#endif /* _MUDDOC_DIFF_H_ */
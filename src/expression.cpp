@@ -0,0 +1,467 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#include <cctype>
+#include <clang-c/Index.h>
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclTemplate.h>
+#include "expression.h"
+#include "utility.h"
+
+namespace muddoc {
+
+/* ========================================================================
+ * Predicates
+ * ======================================================================== */
+
+/* The names of the kinds, in the order of their bits */
+static const char* __kinds[] = {
+    "namespace", "class", "struct", "union", "enum", "value",
+    "constructor", "destructor", "method"
+};
+
+/* The names of the access, in the order of their bits */
+static const char* __access[] = {
+    "public", "protected", "private"
+};
+
+/* Get the bit of the kind of a cursor, or 0 for other kinds */
+static unsigned
+kind(CXCursorKind kind)
+{
+    switch (kind) {
+        case CXCursor_Namespace:        return 1 << 0;
+        case CXCursor_ClassDecl:        return 1 << 1;
+        case CXCursor_StructDecl:       return 1 << 2;
+        case CXCursor_UnionDecl:        return 1 << 3;
+        case CXCursor_EnumDecl:         return 1 << 4;
+        case CXCursor_EnumConstantDecl: return 1 << 5;
+        case CXCursor_Constructor:      return 1 << 6;
+        case CXCursor_Destructor:       return 1 << 7;
+        case CXCursor_CXXMethod:        return 1 << 8;
+        default:                        return 0;
+    }
+}
+
+/* Get the bit of the access of a cursor, where non-members are public */
+static unsigned
+access(CX_CXXAccessSpecifier access)
+{
+    switch (access) {
+        case CX_CXXProtected:           return 1 << 1;
+        case CX_CXXPrivate:             return 1 << 2;
+        default:                        return 1 << 0;
+    }
+}
+
+/* Parse a comma separated list of names into a set of bits */
+static bool
+names(const std::string& list, const char* const* names, size_t count,
+        unsigned& mask)
+{
+    mask = 0;
+    size_t pos = 0;
+    do {
+        size_t end = list.find(',', pos);
+        std::string name = list.substr(pos,
+                end == std::string::npos ? std::string::npos : end - pos);
+        size_t i = 0;
+        while (i < count && name != names[i]) {
+            ++i;
+        }
+        if (i == count) {
+            return false;
+        }
+        mask |= 1 << i;
+        pos = end == std::string::npos ? end : end + 1;
+    } while (pos != std::string::npos);
+    return true;
+}
+
+/* ========================================================================
+ * Expression
+ * ======================================================================== */
+
+struct Expression::Subject
+{
+    CXCursor cursor;
+    bool named = false;
+    std::string name;
+    bool located = false;
+    std::string file;
+
+    /* The qualified name of the declaration */
+    const std::string& qualified()
+    {
+        if (!named) {
+            named = true;
+            CXCursorKind kind = clang_getCursorKind(cursor);
+            if (clang_isDeclaration(kind)) {
+                auto decl = static_cast<const clang::Decl*>(cursor.data[0]);
+                auto nd = llvm::dyn_cast_or_null<clang::NamedDecl>(decl);
+                if (nd != nullptr) {
+                    name = nd->getQualifiedNameAsString();
+                }
+            }
+        }
+        return name;
+    }
+
+    /* The name of the file of the declaration */
+    const std::string& path()
+    {
+        if (!located) {
+            located = true;
+            CXString filename;
+            unsigned line, column;
+            clang_getPresumedLocation(clang_getCursorLocation(cursor),
+                    &filename, &line, &column);
+            file = str(filename);
+        }
+        return file;
+    }
+};
+
+bool
+Expression::parse(const std::string& text, std::string& error)
+{
+    // Split the text in parentheses and words.
+    std::vector<std::string> tokens;
+    for (size_t pos = 0; pos < text.size(); ) {
+        if (::isspace(static_cast<unsigned char>(text[pos]))) {
+            ++pos;
+        }
+        else
+        if (text[pos] == '(' || text[pos] == ')') {
+            tokens.push_back(text.substr(pos++, 1));
+        }
+        else {
+            size_t end = pos;
+            while (end < text.size() && text[end] != '(' && text[end] != ')'
+                    && !::isspace(static_cast<unsigned char>(text[end])))
+            {
+                ++end;
+            }
+            tokens.push_back(text.substr(pos, end - pos));
+            pos = end;
+        }
+    }
+    if (tokens.empty()) {
+        error = "empty expression";
+        return false;
+    }
+
+    // Compile into a copy, such that a failure leaves the program intact.
+    bool combine = !_program.empty();
+    std::vector<Op> program;
+    program.swap(_program);
+    size_t pos = 0;
+    bool ok = expression(tokens, pos, error);
+    if (ok && pos != tokens.size()) {
+        error = "unexpected '" + tokens[pos] + "'";
+        ok = false;
+    }
+    if (!ok) {
+        _program.swap(program);
+        return false;
+    }
+    if (combine) {
+        program.insert(program.end(), _program.begin(), _program.end());
+        program.push_back(Op{ Op::And, std::string(), 0 });
+        _program.swap(program);
+    }
+    return true;
+}
+
+bool
+Expression::expression(const std::vector<std::string>& tokens, size_t& pos,
+        std::string& error)
+{
+    if (!term(tokens, pos, error)) {
+        return false;
+    }
+    while (pos < tokens.size() && tokens[pos] == "or") {
+        if (!term(tokens, ++pos, error)) {
+            return false;
+        }
+        _program.push_back(Op{ Op::Or, std::string(), 0 });
+    }
+    return true;
+}
+
+bool
+Expression::term(const std::vector<std::string>& tokens, size_t& pos,
+        std::string& error)
+{
+    if (!factor(tokens, pos, error)) {
+        return false;
+    }
+    while (pos < tokens.size() && tokens[pos] == "and") {
+        if (!factor(tokens, ++pos, error)) {
+            return false;
+        }
+        _program.push_back(Op{ Op::And, std::string(), 0 });
+    }
+    return true;
+}
+
+bool
+Expression::factor(const std::vector<std::string>& tokens, size_t& pos,
+        std::string& error)
+{
+    if (pos == tokens.size()) {
+        error = "unexpected end of expression";
+        return false;
+    }
+    const std::string& token = tokens[pos++];
+    if (token == "not") {
+        if (!factor(tokens, pos, error)) {
+            return false;
+        }
+        _program.push_back(Op{ Op::Not, std::string(), 0 });
+        return true;
+    }
+    if (token == "(") {
+        if (!expression(tokens, pos, error)) {
+            return false;
+        }
+        if (pos == tokens.size() || tokens[pos] != ")") {
+            error = "missing ')'";
+            return false;
+        }
+        ++pos;
+        return true;
+    }
+    return predicate(token, error);
+}
+
+bool
+Expression::predicate(const std::string& token, std::string& error)
+{
+    if (token == "documented") {
+        _program.push_back(Op{ Op::Documented, std::string(), 0 });
+        return true;
+    }
+    size_t colon = token.find(':');
+    std::string key = token.substr(0, colon);
+    std::string arg = colon == std::string::npos
+            ? std::string() : token.substr(colon + 1);
+    if (colon == std::string::npos || arg.empty()) {
+        error = "unknown predicate '" + token + "'";
+        return false;
+    }
+    Op op { Op::Name, std::string(), 0 };
+    if (key == "name") {
+        op.pattern = arg.compare(0, 2, "::") == 0 ? arg.substr(2) : arg;
+    }
+    else
+    if (key == "file") {
+        op.code = Op::File;
+        op.pattern = arg;
+    }
+    else
+    if (key == "kind") {
+        op.code = Op::Kind;
+        if (!names(arg, __kinds, sizeof(__kinds) / sizeof(*__kinds),
+                    op.mask))
+        {
+            error = "unknown kind in '" + token + "'";
+            return false;
+        }
+    }
+    else
+    if (key == "access") {
+        op.code = Op::Access;
+        if (!names(arg, __access, sizeof(__access) / sizeof(*__access),
+                    op.mask))
+        {
+            error = "unknown access in '" + token + "'";
+            return false;
+        }
+    }
+    else {
+        error = "unknown predicate '" + token + "'";
+        return false;
+    }
+    _program.push_back(op);
+    return true;
+}
+
+Expression::Value
+Expression::evaluate(const CXCursor& cursor) const
+{
+    if (_program.empty()) {
+        return Value{ true, true, true };
+    }
+
+    // The program has a bounded depth, so a small stack is mostly enough.
+    Subject subject;
+    subject.cursor = cursor;
+    std::vector<Value> stack;
+    stack.reserve(8);
+    for (const auto& op: _program) {
+        switch (op.code) {
+            case Op::And: {
+                Value rhs = stack.back();
+                stack.pop_back();
+                Value& lhs = stack.back();
+                lhs = Value{ lhs.self && rhs.self, lhs.any && rhs.any,
+                        lhs.all && rhs.all };
+                break; }
+            case Op::Or: {
+                Value rhs = stack.back();
+                stack.pop_back();
+                Value& lhs = stack.back();
+                lhs = Value{ lhs.self || rhs.self, lhs.any || rhs.any,
+                        lhs.all || rhs.all };
+                break; }
+            case Op::Not: {
+                Value& value = stack.back();
+                value = Value{ !value.self, !value.all, !value.any };
+                break; }
+            default:
+                stack.push_back(evaluate(op, subject));
+                break;
+        }
+    }
+    return stack.back();
+}
+
+Expression::Value
+Expression::evaluate(const Op& op, Subject& subject) const
+{
+    switch (op.code) {
+        case Op::Name: {
+            // A name matches a scope and all of its members, and a scope of
+            // which the name is not matched may still have members that are.
+            const std::string& name = subject.qualified();
+            if (name.empty()) {
+                return Value{ false, false, false };
+            }
+            for (size_t end = name.find("::"); end != std::string::npos;
+                 end = name.find("::", end + 2))
+            {
+                if (glob(op.pattern, name.substr(0, end))) {
+                    return Value{ true, true, true };
+                }
+            }
+            if (glob(op.pattern, name)) {
+                return Value{ true, true, true };
+            }
+            return Value{ false, glob(op.pattern, name + "::", true), false };
+        }
+        case Op::Kind: {
+            bool self = (kind(clang_getCursorKind(subject.cursor)) & op.mask)
+                    != 0;
+            return Value{ self, true, false };
+        }
+        case Op::Access: {
+            // The members of a scope that is not accessible are not either.
+            bool self = (access(clang_getCXXAccessSpecifier(subject.cursor))
+                    & op.mask) != 0;
+            return Value{ self, self, false };
+        }
+        case Op::File:
+            return Value{ glob(op.pattern, subject.path()), true, false };
+        case Op::Documented: {
+            CXString comment = clang_Cursor_getRawCommentText(subject.cursor);
+            bool self = clang_getCString(comment) != nullptr;
+            clang_disposeString(comment);
+            return Value{ self, true, false };
+        }
+        default:
+            return Value{ false, false, false };
+    }
+}
+
+bool
+Expression::glob(const std::string& pattern, const std::string& text,
+        bool prefix)
+{
+    // Match greedily, and on a mismatch let the last '*' take one more
+    // character.
+    size_t p = 0;
+    size_t t = 0;
+    size_t star = std::string::npos;
+    size_t mark = 0;
+    while (t < text.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == text[t])) {
+            ++p, ++t;
+        }
+        else
+        if (p < pattern.size() && pattern[p] == '*') {
+            star = p++;
+            mark = t;
+        }
+        else
+        if (star != std::string::npos) {
+            p = star + 1;
+            t = ++mark;
+        }
+        else {
+            return false;
+        }
+    }
+    if (prefix) {
+        return true;
+    }
+    while (p < pattern.size() && pattern[p] == '*') {
+        ++p;
+    }
+    return p == pattern.size();
+}
+
+/* ========================================================================
+ * ExpressionFilter
+ * ======================================================================== */
+
+ExpressionFilter::ExpressionFilter(const Filter& base,
+        const Expression& expression)
+    : _base(base.clone()), _expression(expression)
+{
+}
+
+bool
+ExpressionFilter::match(const CXCursor& cursor) const
+{
+    return test(cursor) == Accept;
+}
+
+Filter::Match
+ExpressionFilter::test(const CXCursor& cursor) const
+{
+    Match match = _base->test(cursor);
+    if (match == Skip) {
+        return Skip;
+    }
+    Expression::Value value = _expression.evaluate(cursor);
+    if (match == Accept && value.self) {
+        return Accept;
+    }
+    return value.any ? Enter : Skip;
+}
+
+} // namespace muddoc
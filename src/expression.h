@@ -0,0 +1,222 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#ifndef _MUDDOC_EXPRESSION_H_
+#define _MUDDOC_EXPRESSION_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <clang-c/Index.h>
+#include "visitor.h"
+
+namespace muddoc {
+
+/**
+ * @brief A compiled filter expression over declarations.
+ *
+ * @details
+ * An expression combines predicates on a declaration with @c and, @c or,
+ * @c not and parentheses, where @c and binds stronger than @c or. The
+ * predicates are:
+ *
+ * - @c name:GLOB, the qualified name of the declaration, or that of one of
+ *   its enclosing scopes, matches GLOB. So @c name:acme::net selects the
+ *   namespace and everything in it.
+ * - @c kind:KIND,..., the declaration is one of the kinds @c namespace,
+ *   @c class, @c struct, @c union, @c enum, @c value, @c constructor,
+ *   @c destructor or @c method.
+ * - @c access:ACCESS,..., the declaration has one of the access @c public,
+ *   @c protected or @c private. A declaration that is not a member is
+ *   public.
+ * - @c file:GLOB, the declaration is in a file that matches GLOB.
+ * - @c documented, the declaration has a documentation comment.
+ *
+ * In a GLOB, a @c * matches any sequence of characters, including "::" and
+ * "/", and a @c ? matches any single character.
+ *
+ * The expression is compiled once into a postfix program. Besides telling
+ * whether a declaration matches, it tells whether any of the declarations
+ * in its scope may match, such that a scope of which nothing matches is
+ * skipped without being visited.
+ */
+class Expression
+{
+public:
+    /**
+     * @brief The outcome of evaluating an expression.
+     */
+    struct Value
+    {
+        /** True if the declaration itself matches */
+        bool self;
+
+        /** True if any declaration in its scope may match */
+        bool any;
+
+        /** True if all declarations in its scope match */
+        bool all;
+    };
+
+    /**
+     * @brief Create an empty expression, that matches everything.
+     */
+    Expression() = default;
+
+    /**
+     * @brief Compile an expression.
+     *
+     * @details
+     * If the expression is not empty, the new expression is combined with
+     * the existing one with @c and.
+     *
+     * @param text The text of the expression.
+     * @param error Set to the reason the expression is not valid.
+     * @return True if the expression is valid.
+     */
+    bool parse(const std::string& text, std::string& error);
+
+    /**
+     * @brief Check whether the expression is empty.
+     *
+     * @return True if nothing has been compiled.
+     */
+    bool empty() const { return _program.empty(); }
+
+    /**
+     * @brief Evaluate the expression for a declaration.
+     *
+     * @param cursor The declaration.
+     * @return Whether the declaration, and the declarations in its scope,
+     * match.
+     */
+    Value evaluate(const CXCursor& cursor) const;
+
+    /**
+     * @brief Match a text against a glob pattern.
+     *
+     * @param pattern The pattern, where @c * matches any sequence and @c ?
+     * any single character.
+     * @param text The text to match.
+     * @param prefix True to match if @p text can be extended to a text that
+     * matches.
+     * @return True if the text matches.
+     */
+    static bool glob(const std::string& pattern, const std::string& text,
+            bool prefix = false);
+
+private:
+    /* An instruction of the program */
+    struct Op
+    {
+        /* The operation */
+        enum Code { Name, Kind, Access, File, Documented, And, Or, Not } code;
+
+        /* The pattern of a name or file */
+        std::string pattern;
+
+        /* The set of kinds or access */
+        unsigned mask;
+    };
+
+    /* The attributes of a declaration, computed on first use */
+    struct Subject;
+
+    /* Compile an expression, a term and a factor */
+    bool expression(const std::vector<std::string>& tokens, size_t& pos,
+            std::string& error);
+    bool term(const std::vector<std::string>& tokens, size_t& pos,
+            std::string& error);
+    bool factor(const std::vector<std::string>& tokens, size_t& pos,
+            std::string& error);
+
+    /* Compile a predicate */
+    bool predicate(const std::string& token, std::string& error);
+
+    /* Evaluate a predicate */
+    Value evaluate(const Op& op, Subject& subject) const;
+
+    /* The program in postfix order */
+    std::vector<Op> _program;
+};
+
+/**
+ * @brief Create a filter from an expression.
+ *
+ * @details
+ * A declaration matches if it matches both the base filter and the
+ * expression. A namespace, class or enumeration that does not match itself
+ * is still entered if any of its members may match, otherwise the whole
+ * scope is skipped.
+ */
+class ExpressionFilter: public Filter
+{
+public:
+    /**
+     * @brief Create a filter for an expression.
+     *
+     * @param base The filter the declarations have to match as well.
+     * @param expression The expression, which has to outlive the filter.
+     */
+    ExpressionFilter(const Filter& base, const Expression& expression);
+
+    /**
+     * @brief Clone this object.
+     *
+     * @return A new instance that is an idential copy of this instance.
+     */
+    Filter* clone() const override
+    {
+        return new ExpressionFilter(*_base, _expression);
+    }
+
+    /**
+     * @brief verify if the cursor matches the filter condition.
+     *
+     * @param cursor The language construct to match.
+     * @return True if the match is successful.
+     */
+    bool match(const CXCursor& cursor) const override;
+
+    /**
+     * @brief Test the cursor against the filter condition.
+     *
+     * @param cursor The language construct to test.
+     * @return Whether to generate, enter or skip the language construct.
+     */
+    Match test(const CXCursor& cursor) const override;
+
+private:
+    /** The filter to match as well. */
+    std::unique_ptr<Filter> _base;
+
+    /** The expression to match. */
+    const Expression& _expression;
+};
+
+} // namespace muddoc
+
+#endif /* _MUDDOC_EXPRESSION_H_ */
@@ -0,0 +1,80 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#include "fingerprint.h"
+
+namespace muddoc {
+
+/* The FNV-1a offset basis and prime of 64 bits */
+static const uint64_t __basis = 14695981039346656037ull;
+static const uint64_t __prime = 1099511628211ull;
+
+Fingerprint::Fingerprint()
+    : _value(__basis)
+{
+}
+
+Fingerprint&
+Fingerprint::add(const std::string& text)
+{
+    add(static_cast<uint64_t>(text.size()));
+    add(text.data(), text.size());
+    return *this;
+}
+
+Fingerprint&
+Fingerprint::add(uint64_t value)
+{
+    // Add the bytes in little endian order, regardless of the platform.
+    unsigned char bytes[8];
+    for (size_t i = 0; i < sizeof(bytes); ++i) {
+        bytes[i] = static_cast<unsigned char>(value >> (8 * i));
+    }
+    add(bytes, sizeof(bytes));
+    return *this;
+}
+
+void
+Fingerprint::add(const void* data, size_t size)
+{
+    auto bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        _value = (_value ^ bytes[i]) * __prime;
+    }
+}
+
+std::string
+Fingerprint::hex(uint64_t value)
+{
+    static const char digits[] = "0123456789abcdef";
+    std::string result(16, '0');
+    for (size_t i = 16; i-- > 0; value >>= 4) {
+        result[i] = digits[value & 0xf];
+    }
+    return result;
+}
+
+} // namespace muddoc
@@ -0,0 +1,96 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#ifndef _MUDDOC_FINGERPRINT_H_
+#define _MUDDOC_FINGERPRINT_H_
+
+#include <cstdint>
+#include <string>
+
+namespace muddoc {
+
+/**
+ * @brief Stable hash of the content of a description.
+ *
+ * @details
+ * A 64-bit FNV-1a hash that is fed field by field. Every text is preceded by
+ * its length, such that moving text from one field to the next changes the
+ * hash. The hash only depends on the bytes that are added, so it is the
+ * same on every platform and in every run.
+ *
+ * A description of a scope adds the hashes of its members, in the order
+ * they are output, such that its hash covers the whole scope.
+ */
+class Fingerprint
+{
+public:
+    /**
+     * @brief Create an empty fingerprint.
+     */
+    Fingerprint();
+
+    /**
+     * @brief Add a text.
+     *
+     * @param text The text to add.
+     * @return This fingerprint.
+     */
+    Fingerprint& add(const std::string& text);
+
+    /**
+     * @brief Add a number, like the hash of a member.
+     *
+     * @param value The number to add.
+     * @return This fingerprint.
+     */
+    Fingerprint& add(uint64_t value);
+
+    /**
+     * @brief Get the hash.
+     *
+     * @return The hash of everything that has been added, never 0.
+     */
+    uint64_t value() const { return _value != 0 ? _value : 1; }
+
+    /**
+     * @brief Format a hash.
+     *
+     * @param value The hash to format.
+     * @return The hash as 16 lower case hexadecimal digits.
+     */
+    static std::string hex(uint64_t value);
+
+private:
+    /* Add the bytes of a buffer */
+    void add(const void* data, size_t size);
+
+    /* The hash so far */
+    uint64_t _value;
+};
+
+} // namespace muddoc
+
+#endif /* _MUDDOC_FINGERPRINT_H_ */
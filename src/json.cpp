@@ -0,0 +1,262 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#include "descriptor.h"
+#include "fingerprint.h"
+#include "json.h"
+#include "utility.h"
+#include "warn_error.h"
+
+namespace muddoc {
+
+JsonSink::JsonSink(std::ostream& ostr, bool strict)
+    : _ostr(ostr), _strict(strict), _symbols(nullptr), _scope(false),
+      _hash(0), _parameters(false), _size(0)
+{
+}
+
+void
+JsonSink::begin(const std::string& file, const SymbolIndex& symbols)
+{
+    _symbols = &symbols;
+    _unresolved.clear();
+    _reported.clear();
+    _first.clear();
+    write("{\"file\":" + quote(file) + ",\"members\":[");
+    _first.push_back(true);
+}
+
+void
+JsonSink::end(const std::string& file, uint64_t hash)
+{
+    close(hash);
+    _symbols = nullptr;
+    if (_strict && !_unresolved.empty()) {
+        warn("unresolved-ref", SymbolIndex::summary(_unresolved));
+    }
+}
+
+void
+JsonSink::begin(const NamespaceDescriptor& descriptor)
+{
+    open(descriptor, "namespace");
+    declared(true, 0);
+}
+
+void
+JsonSink::end(const NamespaceDescriptor& descriptor)
+{
+    close(descriptor.hash());
+}
+
+void
+JsonSink::begin(const ClassDescriptor& descriptor)
+{
+    open(descriptor, "class");
+    write(",\"declaration\":" + quote(descriptor.declaration()));
+    declared(true, 0);
+}
+
+void
+JsonSink::end(const ClassDescriptor& descriptor)
+{
+    close(descriptor.hash());
+}
+
+void
+JsonSink::begin(const EnumDescriptor& descriptor)
+{
+    open(descriptor, "enum");
+    declared(true, 0);
+}
+
+void
+JsonSink::end(const EnumDescriptor& descriptor)
+{
+    close(descriptor.hash());
+}
+
+void
+JsonSink::method(const ConstructorDescriptor& descriptor)
+{
+    open(descriptor, "constructor");
+    write(",\"declaration\":" + quote(descriptor.declaration()));
+    declared(false, descriptor.hash());
+}
+
+void
+JsonSink::method(const DestructorDescriptor& descriptor)
+{
+    open(descriptor, "destructor");
+    write(",\"declaration\":" + quote(descriptor.declaration()));
+    declared(false, descriptor.hash());
+}
+
+void
+JsonSink::method(const MethodDescriptor& descriptor)
+{
+    open(descriptor, "method");
+    write(",\"declaration\":" + quote(descriptor.declaration()));
+    declared(false, descriptor.hash());
+}
+
+void
+JsonSink::value(const EnumConstantDescriptor& descriptor)
+{
+    open(descriptor, "value");
+    declared(false, descriptor.hash());
+}
+
+void
+JsonSink::param(const ParamDescriptor& descriptor)
+{
+    write(_parameters ? "," : ",\"parameters\":[");
+    _parameters = true;
+    write("{\"index\":" + std::to_string(descriptor.index())
+            + ",\"name\":" + quote(descriptor.name())
+            + ",\"brief\":" + text(descriptor.description()) + "}");
+}
+
+void
+JsonSink::returns(const std::string& xml)
+{
+    parameters();
+    write(",\"return\":" + text(xml));
+}
+
+void
+JsonSink::brief(const std::string& xml)
+{
+    parameters();
+    write(",\"brief\":" + text(xml));
+}
+
+void
+JsonSink::detailed(const std::string& xml)
+{
+    // The detailed text is the last text event of a declaration, so the
+    // members of a scope follow it, and any other declaration ends with it.
+    parameters();
+    write(",\"detailed\":" + text(xml));
+    references();
+    if (_scope) {
+        write(",\"members\":[");
+        _first.push_back(true);
+    }
+    else {
+        hashed(_hash);
+    }
+}
+
+void
+JsonSink::open(const Descriptor& descriptor, const char* kind)
+{
+    if (!_first.back()) {
+        write(",");
+    }
+    _first.back() = false;
+    write(std::string("{\"kind\":\"") + kind + "\""
+            + ",\"name\":" + quote(descriptor.name())
+            + ",\"qualified\":" + quote(descriptor.qualified())
+            + ",\"usr\":" + quote(descriptor.usr()));
+}
+
+void
+JsonSink::declared(bool scope, uint64_t hash)
+{
+    _scope = scope;
+    _hash = hash;
+    _parameters = false;
+}
+
+void
+JsonSink::parameters()
+{
+    if (_parameters) {
+        write("]");
+        _parameters = false;
+    }
+}
+
+void
+JsonSink::close(uint64_t hash)
+{
+    _first.pop_back();
+    write("]");
+    hashed(hash);
+}
+
+void
+JsonSink::hashed(uint64_t hash)
+{
+    if (hash != 0) {
+        write(",\"hash\":\"" + Fingerprint::hex(hash) + "\"");
+    }
+    write("}");
+}
+
+std::string
+JsonSink::text(const std::string& xml)
+{
+    // Strip the markup of the text and resolve the cross-references in it
+    // against the index of all the symbols, they are output separately.
+    std::string plain;
+    std::vector<std::string> unresolved;
+    _symbols->strip(xml, plain, _references, unresolved);
+    for (auto& ref: unresolved) {
+        if (_reported.insert(ref).second) {
+            _unresolved.push_back(std::move(ref));
+        }
+    }
+    return quote(plain);
+}
+
+void
+JsonSink::references()
+{
+    if (_references.empty()) {
+        return;
+    }
+    write(",\"references\":[");
+    for (size_t i = 0; i < _references.size(); ++i) {
+        const auto& reference = _references[i];
+        write(std::string(i > 0 ? "," : "")
+                + "{\"name\":" + quote(reference.name)
+                + (reference.usr.empty()
+                        ? "" : ",\"usr\":" + quote(reference.usr)) + "}");
+    }
+    write("]");
+    _references.clear();
+}
+
+void
+JsonSink::write(const std::string& text)
+{
+    _ostr << text;
+    _size += text.size();
+}
+
+} // namespace muddoc
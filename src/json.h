@@ -0,0 +1,179 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#ifndef _MUDDOC_JSON_H_
+#define _MUDDOC_JSON_H_
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "sink.h"
+#include "symbols.h"
+
+namespace muddoc {
+
+/** Forward declaration */
+class Descriptor;
+class ParamDescriptor;
+
+/**
+ * @brief Sink that outputs the documentation in JSON.
+ *
+ * @details
+ * The documentation of a file is output as a single JSON object, that is
+ * written as the events arrive without building up the document first. Every
+ * declaration is an object with its @c kind, which contains the objects of
+ * its members in declaration order:
+ *
+ * @code
+ * {"file":"FILE","members":[
+ *   {"kind":"namespace","name":"NAME","qualified":"QUALIFIED","usr":"USR",
+ *    "brief":"BRIEF","detailed":"DETAILED",
+ *    "references":[{"name":"NAME","usr":"USR"}],"members":[
+ *     {"kind":"class",...,"declaration":"DECLARATION",
+ *      "parameters":[{"index":0,"name":"NAME","brief":"BRIEF"}],
+ *      "members":[
+ *        {"kind":"method",...,"return":"RETURN","hash":"HASH"}
+ *      ],"hash":"HASH"}
+ *   ],"hash":"HASH"}
+ * ],"hash":"HASH"}
+ * @endcode
+ *
+ * The @c kind is one of "namespace", "class", "enum", "constructor",
+ * "destructor", "method" or "value". Unlike the XML, the methods are not
+ * grouped in overload sets. The brief and detailed text, and those of the
+ * parameters and the return value, are plain text without the inline markup
+ * of the XML. The cross-references in them are resolved against the index of
+ * all the symbols of the file and are listed in the @c references of their
+ * declaration, where a reference that cannot be resolved has no @c usr. The
+ * hash is only output if the fingerprints are computed, and as it covers the
+ * members of a scope, it follows them.
+ */
+class JsonSink: public Sink
+{
+public:
+    /**
+     * @brief Create a sink that outputs JSON.
+     *
+     * @param ostr The stream to output the documentation to.
+     * @param strict True to warn about the references that cannot be
+     * resolved, false if only part of the file is documented or if another
+     * sink warns about them already.
+     */
+    JsonSink(std::ostream& ostr, bool strict = true);
+
+    /**
+     * @brief Output the event in JSON, see @c Sink.
+     */
+    void begin(const std::string& file,
+            const SymbolIndex& symbols) override;
+    void end(const std::string& file, uint64_t hash) override;
+    void begin(const NamespaceDescriptor& descriptor) override;
+    void end(const NamespaceDescriptor& descriptor) override;
+    void begin(const ClassDescriptor& descriptor) override;
+    void end(const ClassDescriptor& descriptor) override;
+    void begin(const EnumDescriptor& descriptor) override;
+    void end(const EnumDescriptor& descriptor) override;
+    void method(const ConstructorDescriptor& descriptor) override;
+    void method(const DestructorDescriptor& descriptor) override;
+    void method(const MethodDescriptor& descriptor) override;
+    void value(const EnumConstantDescriptor& descriptor) override;
+    void param(const ParamDescriptor& descriptor) override;
+    void returns(const std::string& text) override;
+    void brief(const std::string& text) override;
+    void detailed(const std::string& text) override;
+
+    /**
+     * @brief Get the number of bytes that have been output.
+     *
+     * @return The number of bytes output so far.
+     */
+    uint64_t size() const override { return _size; }
+
+private:
+    /* Output the start of the object of a declaration */
+    void open(const Descriptor& descriptor, const char* kind);
+
+    /* Start the text events of a scope or of another declaration */
+    void declared(bool scope, uint64_t hash);
+
+    /* Output the end of the described parameters, if any */
+    void parameters();
+
+    /* Output the end of the members and of the object of a scope */
+    void close(uint64_t hash);
+
+    /* Output the hash and the end of an object */
+    void hashed(uint64_t hash);
+
+    /* Return the quoted plain text of a comment and collect its references */
+    std::string text(const std::string& xml);
+
+    /* Output the references collected for a declaration, if any */
+    void references();
+
+    /* Output a text */
+    void write(const std::string& text);
+
+    /* The stream to output to */
+    std::ostream& _ostr;
+
+    /* True to warn about unresolved references */
+    bool _strict;
+
+    /* The symbols to resolve the references against, during a file */
+    const SymbolIndex* _symbols;
+
+    /* True if the current declaration is a scope, which has members */
+    bool _scope;
+
+    /* The hash of the current declaration, if it is not a scope */
+    uint64_t _hash;
+
+    /* True if the parameters array of the declaration is open */
+    bool _parameters;
+
+    /* The references in the comments of the current declaration */
+    std::vector<SymbolIndex::Reference> _references;
+
+    /* The names of the unresolved references, in order of appearance */
+    std::vector<std::string> _unresolved;
+
+    /* The names of the unresolved references, to report each once */
+    std::unordered_set<std::string> _reported;
+
+    /* True if the next member is the first of its scope, per scope */
+    std::vector<bool> _first;
+
+    /* The number of bytes output so far */
+    uint64_t _size;
+};
+
+} // namespace muddoc
+
+#endif /* _MUDDOC_JSON_H_ */
@@ -0,0 +1,82 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#ifndef _MUDDOC_LIBRARY_H_
+#define _MUDDOC_LIBRARY_H_
+
+/**
+ * @file
+ * @brief The public interface of the muddoc library.
+ *
+ * @details
+ * An application that parses C++ with libclang can document its own
+ * translation units in-process by linking with @c libmuddoc and including
+ * this header. The visitor either generates the XML representation of a
+ * translation unit, or passes the descriptions of the declarations to a
+ * listener, a sink that is notified of each description, without
+ * serializing them:
+ *
+ * @code
+ * class Printer: public muddoc::Listener
+ * {
+ * public:
+ *     void described(const muddoc::MethodDescriptor& method) override
+ *     {
+ *         std::cout << method.qualified() << ": " << method.brief() << "\n";
+ *     }
+ * };
+ *
+ * Printer printer;
+ * muddoc::Visitor visitor(unit);
+ * muddoc::FileFilter filter(path);
+ * visitor.generate(printer, filter, path);
+ * @endcode
+ *
+ * To output the documentation in-process, the visitor passes the events of
+ * the declarations to a sink, like the @c XmlSink, the @c JsonSink or the
+ * @c BinarySink. A
+ * @c Sinks object passes them on to several sinks, such that all output
+ * formats are generated from a single walk of the translation unit.
+ *
+ * The translation unit has to be parsed with
+ * @c CXTranslationUnit_DetailedPreprocessingRecord and remains owned by the
+ * application. The diagnostics are added to the collector of the calling
+ * thread, see @c diagnostics, and the options of the descriptions, like
+ * @c Descriptor::comments, apply to all the visitors of the process.
+ */
+
+#include <clang/AST/DeclTemplate.h>
+#include "binary.h"
+#include "descriptor.h"
+#include "expression.h"
+#include "fingerprint.h"
+#include "json.h"
+#include "listener.h"
+#include "sink.h"
+#include "visitor.h"
+#include "warn_error.h"
+
+#endif /* _MUDDOC_LIBRARY_H_ */
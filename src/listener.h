@@ -0,0 +1,146 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#ifndef _MUDDOC_LISTENER_H_
+#define _MUDDOC_LISTENER_H_
+
+#include "sink.h"
+
+namespace muddoc {
+
+/**
+ * @brief Receiver of the descriptions of the declarations.
+ *
+ * @details
+ * A listener is a sink that is notified of every declaration that has been
+ * described, with the descriptor itself, such that an application that
+ * embeds muddoc can use the descriptions in-process instead of parsing the
+ * XML output. It is passed to @c Visitor::generate like any other sink, or
+ * added to a @c Sinks object next to the output formats. The descriptor is
+ * only valid for the duration of the call.
+ *
+ * The notifications are the @c begin events of the scopes and the events of
+ * their members, so a scope is described before its members. A listener
+ * that needs to know where a scope ends also overrides its @c end event.
+ * Likewise, the comments of a declaration follow its notification as the
+ * text events of the sink, like @c brief and @c detailed. Their text holds
+ * the inline markup of the XML, with the cross-references unresolved; they
+ * can be resolved against the index that is passed to the @c begin of the
+ * file, see @c SymbolIndex. By default a notification is ignored, so a
+ * listener only overrides the notifications it is interested in.
+ */
+class Listener: public Sink
+{
+public:
+    /**
+     * @brief Notify the description of the event, see @c Sink.
+     */
+    void begin(const NamespaceDescriptor& descriptor) override
+    {
+        described(descriptor);
+    }
+    void begin(const ClassDescriptor& descriptor) override
+    {
+        described(descriptor);
+    }
+    void begin(const EnumDescriptor& descriptor) override
+    {
+        described(descriptor);
+    }
+    void method(const ConstructorDescriptor& descriptor) override
+    {
+        described(descriptor);
+    }
+    void method(const DestructorDescriptor& descriptor) override
+    {
+        described(descriptor);
+    }
+    void method(const MethodDescriptor& descriptor) override
+    {
+        described(descriptor);
+    }
+    void value(const EnumConstantDescriptor& descriptor) override
+    {
+        described(descriptor);
+    }
+
+    /**
+     * @brief A namespace has been described.
+     *
+     * @param descriptor The description of the namespace.
+     */
+    virtual void described(const NamespaceDescriptor& /* descriptor */) {}
+
+    /**
+     * @brief A class, struct or union has been described.
+     *
+     * @param descriptor The description of the class.
+     */
+    virtual void described(const ClassDescriptor& /* descriptor */) {}
+
+    /**
+     * @brief A constructor has been described.
+     *
+     * @param descriptor The description of the constructor.
+     */
+    virtual void described(const ConstructorDescriptor& /* descriptor */) {}
+
+    /**
+     * @brief A destructor has been described.
+     *
+     * @param descriptor The description of the destructor.
+     */
+    virtual void described(const DestructorDescriptor& /* descriptor */) {}
+
+    /**
+     * @brief A method has been described.
+     *
+     * @param descriptor The description of the method.
+     */
+    virtual void described(const MethodDescriptor& /* descriptor */) {}
+
+    /**
+     * @brief An enumeration has been described.
+     *
+     * @param descriptor The description of the enumeration.
+     */
+    virtual void described(const EnumDescriptor& /* descriptor */) {}
+
+    /**
+     * @brief An enumeration constant has been described.
+     *
+     * @param descriptor The description of the constant.
+     */
+    virtual void described(
+            const EnumConstantDescriptor& /* descriptor */) {}
+
+protected:
+    Listener() = default;
+};
+
+} // namespace muddoc
+
+#endif /* _MUDDOC_LISTENER_H_ */
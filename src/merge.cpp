@@ -0,0 +1,302 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#include <algorithm>
+#include "fingerprint.h"
+#include "merge.h"
+
+namespace muddoc {
+
+Merger::Merger()
+    : _doc("doc", XmlAttributes())
+{
+    _root.node = &_doc;
+}
+
+bool
+Merger::merge(std::istream& istr, const std::string& source,
+        std::string& error)
+{
+    XmlReader reader(istr);
+    std::string file = source;
+    unsigned depth = 0;
+    while (true) {
+        switch (reader.next()) {
+            case XmlReader::StartElement:
+                if (reader.name() == "doc") {
+                    const std::string* attr = reader.attribute("file");
+                    file = attr != nullptr ? *attr : source;
+                    ++depth;
+                }
+                else
+                if (depth > 0) {
+                    // Read and merge one top-level symbol at a time
+                    auto node = XmlNode::read(reader, error);
+                    if (node == nullptr) {
+                        return false;
+                    }
+                    insert(_root, std::move(node), file);
+                }
+                break;
+            case XmlReader::EndElement:
+                if (reader.name() == "doc") {
+                    --depth;
+                }
+                break;
+            case XmlReader::Text:
+            case XmlReader::CData:
+                break;
+            case XmlReader::EndDocument:
+                return true;
+            case XmlReader::Error:
+                error = reader.error();
+                return false;
+        }
+    }
+}
+
+void
+Merger::write(std::ostream& ostr)
+{
+    finalize(_root);
+
+    // Resolve the references that could not be resolved in the individual
+    // documents, as the symbol may be documented in another file.
+    SymbolIndex symbols;
+    index(_doc, std::string(), symbols);
+    std::unordered_set<std::string> reported;
+    _unresolved.clear();
+    resolve(_doc, symbols, reported);
+    ostr << _doc;
+}
+
+bool
+Merger::symbol(const XmlNode& node)
+{
+    const std::string& name = node.name();
+    return name == "namespace" || name == "class" || name == "method"
+        || name == "overload-set" || name == "enum";
+}
+
+std::string
+Merger::key(const XmlNode& node)
+{
+    const std::string& name = node.name();
+    if (name == "namespace") {
+        const std::string* qualified = node.attribute("qualified");
+        return qualified != nullptr ? "namespace:" + *qualified : "";
+    }
+    if (name == "class" || name == "method") {
+        XmlNode* usr = node.child("usr");
+        return usr != nullptr ? name + ":" + usr->content() : "";
+    }
+    if (name == "enum" && node.child("usr") != nullptr) {
+        return name + ":" + node.child("usr")->content();
+    }
+    if (name == "overload-set" || name == "enum") {
+        const std::string* attr = node.attribute("name");
+        return attr != nullptr && !attr->empty() ? name + ":" + *attr : "";
+    }
+    return std::string();
+}
+
+void
+Merger::index(const XmlNode& node, const std::string& scope,
+        SymbolIndex& symbols)
+{
+    // The qualified name of a symbol is either explicit or derived from the
+    // name and the enclosing scope.
+    std::string qualified = scope;
+    const XmlNode* usr = node.child("usr");
+    if (usr != nullptr) {
+        const std::string* attr = node.attribute("qualified");
+        const std::string* name = node.attribute("name");
+        const std::string* ns = node.attribute("namespace");
+        if (attr != nullptr) {
+            qualified = *attr;
+        }
+        else
+        if (name != nullptr && ns != nullptr) {
+            qualified = *ns + *name;
+        }
+        else
+        if (name != nullptr) {
+            qualified = scope.empty() ? *name : scope + "::" + *name;
+        }
+        symbols.add(qualified, usr->content());
+    }
+    for (const auto& child: node.children()) {
+        if (child->kind() == XmlNode::Element) {
+            index(*child, qualified, symbols);
+        }
+    }
+}
+
+void
+Merger::resolve(XmlNode& node, const SymbolIndex& symbols,
+        std::unordered_set<std::string>& reported)
+{
+    for (auto& child: node.children()) {
+        if (child->kind() != XmlNode::Element) {
+            continue;
+        }
+        const std::string* name = child->attribute("name");
+        const std::string* scope = child->attribute("scope");
+        if (child->name() != "ref" || name == nullptr || scope == nullptr) {
+            resolve(*child, symbols, reported);
+            continue;
+        }
+
+        // Replace the scope of an unresolved reference with the USR.
+        const std::string* usr = symbols.find(*name, *scope);
+        if (usr == nullptr) {
+            if (reported.insert(*name).second) {
+                _unresolved.push_back(*name);
+            }
+            continue;
+        }
+        XmlNode ref("ref", XmlAttributes{ { "name", *name }, { "usr", *usr } });
+        ref.children() = std::move(child->children());
+        *child = std::move(ref);
+    }
+}
+
+void
+Merger::insert(Symbol& target, std::unique_ptr<XmlNode> node,
+        const std::string& file)
+{
+    // Only elements are merged, any character data in between is dropped.
+    if (node->kind() != XmlNode::Element) {
+        return;
+    }
+
+    // Any element that is not a symbol is a property of the target, where the
+    // first non-empty property is retained. The properties are looked up by
+    // name, as the children of the target include all its merged members.
+    auto& children = target.node->children();
+    if (!symbol(*node)) {
+        auto iter = target.properties.find(node->name());
+        if (iter == target.properties.end()) {
+            target.properties.emplace(node->name(), node.get());
+            children.push_back(std::move(node));
+        }
+        else
+        if (node->name() == "hash") {
+            // The fingerprint of a merged symbol covers all of its parts.
+            std::string merged = iter->second->content();
+            std::string hash = node->content();
+            if (hash != merged) {
+                auto& text = iter->second->children();
+                text.clear();
+                text.emplace_back(new XmlNode(XmlNode::Text, Fingerprint::hex(
+                        Fingerprint().add(merged).add(hash).value())));
+            }
+        }
+        else
+        if (iter->second->content().empty() && !node->content().empty()) {
+            *iter->second = std::move(*node);
+        }
+        return;
+    }
+
+    // Merge a symbol that has been seen before.
+    std::string key = Merger::key(*node);
+    if (!key.empty()) {
+        auto iter = target.members.find(key);
+        if (iter != target.members.end()) {
+            merge(*iter->second, std::move(node), file);
+            return;
+        }
+    }
+
+    // Add a new symbol, and merge its children into it. Even a new symbol may
+    // contain duplicates, like a namespace that is re-opened in the same file.
+    std::unique_ptr<Symbol> member(new Symbol());
+    member->node = node.get();
+    Symbol& added = *member;
+    if (key.empty()) {
+        target.anonymous.push_back(std::move(member));
+    }
+    else {
+        target.members.emplace(key, std::move(member));
+    }
+    std::vector<std::unique_ptr<XmlNode>> nodes;
+    nodes.swap(node->children());
+    children.push_back(std::move(node));
+    record(added, file);
+    for (auto& child: nodes) {
+        insert(added, std::move(child), file);
+    }
+}
+
+void
+Merger::merge(Symbol& target, std::unique_ptr<XmlNode> node,
+        const std::string& file)
+{
+    record(target, file);
+    for (auto& child: node->children()) {
+        insert(target, std::move(child), file);
+    }
+}
+
+void
+Merger::record(Symbol& symbol, const std::string& file)
+{
+    if (symbol.seen.insert(file).second) {
+        symbol.files.push_back(file);
+    }
+}
+
+void
+Merger::finalize(Symbol& symbol)
+{
+    std::vector<std::unique_ptr<XmlNode>> files;
+    for (const auto& file: symbol.files) {
+        files.emplace_back(new XmlNode("file", { { "name", file } }));
+    }
+    auto& children = symbol.node->children();
+    children.insert(children.begin(),
+            std::make_move_iterator(files.begin()),
+            std::make_move_iterator(files.end()));
+
+    // The hash follows the members, as it does in each document.
+    auto hash = symbol.properties.find("hash");
+    if (hash != symbol.properties.end()) {
+        auto iter = std::find_if(children.begin(), children.end(),
+                [&hash](const std::unique_ptr<XmlNode>& child) {
+                    return child.get() == hash->second;
+                });
+        std::rotate(iter, iter + 1, children.end());
+    }
+    for (auto& member: symbol.members) {
+        finalize(*member.second);
+    }
+    for (auto& member: symbol.anonymous) {
+        finalize(*member);
+    }
+}
+
+} // namespace muddoc
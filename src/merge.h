@@ -0,0 +1,185 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#ifndef _MUDDOC_MERGE_H_
+#define _MUDDOC_MERGE_H_
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "symbols.h"
+#include "xml.h"
+
+namespace muddoc {
+
+/**
+ * @brief Merge the XML documentation of several files into one document.
+ *
+ * @details
+ * The documentation of a set of header files usually contains the same
+ * namespaces, and sometimes the same classes, several times. The merger
+ * combines the documents into a single document where each symbol appears
+ * only once:
+ *  * Namespaces are merged by their qualified name.
+ *  * Classes and methods are merged by their USR.
+ *  * Overload sets are merged by their name.
+ *  * Enumerations are merged by their USR, or by their name for older
+ *    documents without one.
+ *
+ * The members of merged symbols are merged recursively. Any other element of
+ * a symbol, like its brief or detailed description, is taken from the first
+ * document that provides it. Each symbol records the files it came from in
+ * @c file elements:
+ *
+ * @code
+ * <class name="NAME" ...>
+ *   <file name="FILE"/>
+ *   ...
+ * </class>
+ * @endcode
+ *
+ * A symbol that is merged from more than one document with different
+ * fingerprints gets a @c hash element that combines them, in the order of
+ * the documents, after all of its members.
+ *
+ * References to symbols that could not be resolved in a single document are
+ * resolved against all the symbols of the merged document.
+ *
+ * Each document is streamed one top-level symbol at a time and the symbols
+ * are looked up by hash, such that merging is linear in the size of the
+ * documents.
+ */
+class Merger
+{
+public:
+    /**
+     * @brief Create an empty merged document.
+     */
+    Merger();
+
+    /**
+     * @brief Merge a document.
+     *
+     * @details
+     * Read a muddoc generated document and merge all its symbols. The file
+     * that is recorded for the symbols is the @c file attribute of the
+     * document, or @p source if there is none.
+     *
+     * @param istr The stream to read the document from.
+     * @param source The name of the document.
+     * @param error Set to the error message if the document is malformed.
+     * @return True if the document has been merged.
+     */
+    bool merge(std::istream& istr, const std::string& source,
+            std::string& error);
+
+    /**
+     * @brief Write the merged document.
+     *
+     * @details
+     * Output the merged document in XML, including the files that each
+     * symbol came from. This should be called once, after all documents have
+     * been merged.
+     *
+     * @param ostr The stream to output the document to.
+     */
+    void write(std::ostream& ostr);
+
+    /**
+     * @brief Get the unresolved references.
+     *
+     * @return The names of the references that could not be resolved when
+     * the merged document was written.
+     */
+    const std::vector<std::string>& unresolved() const { return _unresolved; }
+
+private:
+    /* A symbol in the merged document */
+    struct Symbol
+    {
+        /* The element of the symbol */
+        XmlNode* node;
+
+        /* The members of the symbol by their key */
+        std::unordered_map<std::string, std::unique_ptr<Symbol>> members;
+
+        /* The properties of the symbol by their element name */
+        std::unordered_map<std::string, XmlNode*> properties;
+
+        /* The members of the symbol that cannot be merged */
+        std::vector<std::unique_ptr<Symbol>> anonymous;
+
+        /* The files the symbol came from, in order */
+        std::vector<std::string> files;
+
+        /* The files the symbol came from */
+        std::unordered_set<std::string> seen;
+    };
+
+    /* Return true if the element is a symbol */
+    static bool symbol(const XmlNode& node);
+
+    /* Return the key to merge a symbol by, empty if it cannot be merged */
+    static std::string key(const XmlNode& node);
+
+    /* Insert a node as a child of a symbol */
+    void insert(Symbol& target, std::unique_ptr<XmlNode> node,
+            const std::string& file);
+
+    /* Merge the children of a node into a symbol */
+    void merge(Symbol& target, std::unique_ptr<XmlNode> node,
+            const std::string& file);
+
+    /* Record that a symbol came from a file */
+    void record(Symbol& symbol, const std::string& file);
+
+    /* Add the file elements to a symbol and its members, and the hash last */
+    void finalize(Symbol& symbol);
+
+    /* Add the symbols of an element and its children to the index */
+    static void index(const XmlNode& node, const std::string& scope,
+            SymbolIndex& symbols);
+
+    /* Resolve the references in the children of an element, in place */
+    void resolve(XmlNode& node, const SymbolIndex& symbols,
+            std::unordered_set<std::string>& reported);
+
+    /* The merged document */
+    XmlNode _doc;
+
+    /* The symbols of the merged document */
+    Symbol _root;
+
+    /* The names of the unresolved references */
+    std::vector<std::string> _unresolved;
+};
+
+} // namespace muddoc
+
+#endif /* _MUDDOC_MERGE_H_ */
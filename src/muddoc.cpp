@@ -31,12 +31,20 @@
 #include <clang/AST/Decl.h>
 #include <clang/AST/DeclCXX.h>
 #include <clang/AST/DeclTemplate.h>
+#include <llvm/Support/TimeProfiler.h>
+#include <cstdlib>
 #include <filesystem>
 #include <iomanip>
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <vector>
+#include "diff.h"
+#include "merge.h"
+#include "processor.h"
+#include "profile.h"
+#include "search.h"
+#include "stats.h"
 #include "visitor.h"
 #include "warn_error.h"
 
@@ -44,11 +52,62 @@
 
 using muddoc::warn;
 
-// The stream to write the XML documentation to.
-std::ostream* xml;
+/**
+ * @brief Output the collected diagnostics.
+ *
+ * @param out The default stream to write to.
+ * @param file The file to write to, or @c nullptr for the default stream.
+ * @param format The output format.
+ * @return True if the diagnostics have been written.
+ */
+bool
+report(std::ostream& out, const char* file,
+        muddoc::Diagnostics::Format format)
+{
+    if (file == nullptr) {
+        muddoc::diagnostics().write(out, format);
+        return true;
+    }
+    std::ofstream ostr(file);
+    if (!ostr) {
+        std::cerr << "Error opening warning file " << file << std::endl;
+        return false;
+    }
+    muddoc::diagnostics().write(ostr, format);
+    return true;
+}
 
-// The stream to write any other output to (like warnings, errors).
-std::ostream* out;
+/**
+ * @brief Write the output file, unless it is unchanged.
+ *
+ * @details
+ * An output file that already has the content is left as is, including its
+ * modification time, such that its consumers do not process it again.
+ *
+ * @param file The file to write to.
+ * @param content The content of the file.
+ * @return True if the file has the content.
+ */
+bool
+update(const char* file, const std::string& content)
+{
+    std::error_code error;
+    if (std::filesystem::file_size(file, error) == content.size() && !error) {
+        std::ifstream istr(file, std::ios::binary);
+        std::stringstream existing;
+        existing << istr.rdbuf();
+        if (istr && existing.str() == content) {
+            return true;
+        }
+    }
+    std::ofstream ostr(file, std::ios::binary);
+    if (!ostr) {
+        std::cerr << "Error opening output file " << file << std::endl;
+        return false;
+    }
+    ostr << content;
+    return true;
+}
 
 void
 help(const char* msg = nullptr)
@@ -60,9 +119,12 @@ help(const char* msg = nullptr)
 R"EOF(OVERVIEW: MUD documentation extractor
 
 Extract comments from FILE to an XML representation. This can then be used for
-further analysis or formatting.
+further analysis or formatting. The representations of more than one FILE are
+output in a single 'docs' element, in the order of the FILEs.
 
-USAGE:: muddoc [options] FILE
+USAGE:: muddoc [options] FILE...
+        muddoc [options] --merge FILE...
+        muddoc [options] --diff OLD NEW
 
 OPTIONS:
     --help, -h          Show this help.
@@ -70,8 +132,101 @@ OPTIONS:
                         source file being processed and all references in the
                         documentation will be refered to as FILE. Defaults to
                         the current directory.
-    --output, -o FILE   Write the XML representation to FILE.
+    --output, -o FILE, --output-xml FILE
+                        Write the XML representation to FILE.
+    --output-json FILE  Write the documentation to FILE in JSON, from the same
+                        parse as the other outputs. Without --output, only the
+                        JSON is written. This cannot be used with --merge,
+                        --diff, --symbols-only or --lint.
+    --output-binary FILE
+                        Write the documentation to FILE in the binary format,
+                        from the same parse as the other outputs. Without
+                        --output, the XML is not written. This cannot be used
+                        with --merge, --diff, --symbols-only or --lint.
     --diagnostics, -d   Show clang diagnostic output.
+    --jobs, -j N        Process N FILEs concurrently. Defaults to 1.
+    --merge, -m         Merge the XML representations in FILE... into a single
+                        document. Namespaces, classes and methods that appear
+                        in more than one FILE are only output once.
+    --diff              Compare the XML representations OLD and NEW by the USR
+                        of their symbols, and write the symbols that have been
+                        added, removed or changed in their declaration,
+                        documentation or access.
+    --diff-format FORMAT
+                        Write the differences as 'text' or 'json'. Defaults
+                        to 'text'.
+    --search-index, --output-index FILE
+                        Write a search index of the documented symbols to
+                        FILE in JSON. This cannot be used with --merge.
+    --filter EXPR       Only document the declarations that match EXPR, which
+                        combines 'name:GLOB', 'kind:KIND,...',
+                        'access:ACCESS,...', 'file:GLOB' and 'documented' with
+                        'and', 'or', 'not' and parentheses. A name matches a
+                        scope and all of its members, so
+                        "not name:*::detail" skips every detail namespace
+                        without visiting it. More than one --filter must all
+                        match.
+    --fingerprints      Add a 'hash' element to every symbol, after its
+                        members, that covers its declaration and descriptions,
+                        and for a namespace, class or enumeration the hashes
+                        of its members. The output FILE is not rewritten if
+                        it is unchanged.
+    --symbol NAME       Only document the symbol with the qualified NAME, like
+                        'ns::Class::method', and its members. Only the scopes
+                        that enclose the symbol are looked into.
+    --usr USR           Only document the symbol with the USR, and its members.
+    --symbols-only      Only write the kind, name, USR and location of every
+                        symbol, nested like the declarations, instead of the
+                        documentation. The comments are not parsed nor
+                        validated.
+    --warning-level LEVEL
+                        Only report the warnings of LEVEL and above, where
+                        LEVEL is one of 'note', 'warning' or 'error'. Defaults
+                        to 'note'.
+    --warning-format FORMAT
+                        Report the warnings as 'text', 'json' or 'sarif'.
+                        Defaults to 'text'.
+    --warning-file FILE Write the warnings to FILE.
+    --lint              Only check the comments and report the warnings,
+                        without writing any XML. The references in the comments
+                        are not resolved.
+    --fail-on LEVEL     Exit with a failure if any warning of LEVEL or above is
+                        reported, where LEVEL is one of 'note', 'warning' or
+                        'error'. Defaults to 'warning' with --lint, otherwise
+                        the warnings do not fail.
+    --baseline FILE     Do not report the warnings that are listed in FILE, as
+                        written by --warning-format text. The line numbers are
+                        ignored, so the warnings are matched when code moves.
+    --stats             Show the time spent in each phase and the counters.
+    --stats-json FILE   Write the time spent in each phase and the counters to
+                        FILE in JSON.
+    --memory            Include the peak resident set size and the memory held
+                        by the translation units in the statistics.
+    --count-allocations Include the C++ allocations, per phase and per kind
+                        of descriptor, in the statistics. These include the
+                        allocations of the clang library on the threads of
+                        muddoc, such as those of parsing in the parse phase.
+                        This implies --memory.
+    --report-slowest N  Show the N namespaces, classes and methods that took
+                        the longest to document, including their nested
+                        symbols, with the size of their output and the share
+                        of comment rendering, pretty-printing and
+                        serialization.
+    --fast-comments     Scan the comments straight from the source text
+                        instead of having them parsed by clang. Only a subset
+                        of doxygen is scanned, other comments are still parsed
+                        by clang.
+    --check-fast-comments
+                        Parse the comments by clang, but also scan them and
+                        warn about every comment of which the scanned
+                        description is different.
+    --trace-file FILE   Write a Chrome trace event file with the time spent
+                        parsing, and generating each namespace and class.
+                        The clang frontend events are included when the clang
+                        library supports it.
+    --trace-granularity US
+                        Only trace spans of at least US microseconds. Defaults
+                        to 100.
 
 Recognised clang OPTIONS:
     -DMACRO=VALUE       Add an implicit #define macro definition.
@@ -92,10 +247,36 @@ main(int argc, char** argv)
         "-fsyntax-only",
         "-std=c++17"
     };
-    char *infile = nullptr;
     char *outfile = nullptr;
+    char *jsonfile = nullptr;
+    char *binaryfile = nullptr;
     std::filesystem::path base = std::filesystem::current_path();
     bool diagnostics = false;
+    bool merge = false;
+    bool diff = false;
+    muddoc::Differ::Format diffformat = muddoc::Differ::Text;
+    unsigned jobs = 1;
+    char *searchfile = nullptr;
+    char *warningfile = nullptr;
+    bool stats = false;
+    char *statsfile = nullptr;
+    bool memory = false;
+    bool allocations = false;
+    unsigned slowest = 0;
+    bool minimal = false;
+    muddoc::Descriptor::Comments comments = muddoc::Descriptor::Parsed;
+    char *tracefile = nullptr;
+    unsigned granularity = 100;
+    muddoc::Diagnostics::Format format = muddoc::Diagnostics::Text;
+    muddoc::Diagnostics::Severity level = muddoc::Diagnostics::Note;
+    muddoc::Expression expression;
+    bool fingerprints = false;
+    char *symbol = nullptr;
+    bool usr = false;
+    bool lint = false;
+    bool failing = false;
+    muddoc::Diagnostics::Severity failure = muddoc::Diagnostics::Warning;
+    char *baselinefile = nullptr;
     while (--argc && (*++argv)[0] == '-') {
         if (::strcmp(*argv, "--help") == 0 || ::strcmp(*argv, "-h") == 0) {
             help();
@@ -110,7 +291,9 @@ main(int argc, char** argv)
             base = std::filesystem::path(*argv);
         }
         else
-        if (::strcmp(*argv, "--output") == 0 || ::strcmp(*argv, "-o") == 0) {
+        if (::strcmp(*argv, "--output") == 0 || ::strcmp(*argv, "-o") == 0 ||
+            ::strcmp(*argv, "--output-xml") == 0)
+        {
             if (argc <= 2) {
                 help("Option --output,-o requires an argument."); 
             }
@@ -118,10 +301,210 @@ main(int argc, char** argv)
             outfile = *argv;
         }
         else
+        if (::strcmp(*argv, "--output-json") == 0) {
+            if (argc <= 2) {
+                help("Option --output-json requires an argument.");
+            }
+            --argc, ++argv;
+            jsonfile = *argv;
+        }
+        else
+        if (::strcmp(*argv, "--output-binary") == 0) {
+            if (argc <= 2) {
+                help("Option --output-binary requires an argument.");
+            }
+            --argc, ++argv;
+            binaryfile = *argv;
+        }
+        else
         if (::strcmp(*argv, "--diagnostics") == 0 || ::strcmp(*argv, "-d") == 0) {
             diagnostics = true;
         }
         else
+        if (::strcmp(*argv, "--merge") == 0 || ::strcmp(*argv, "-m") == 0) {
+            merge = true;
+        }
+        else
+        if (::strcmp(*argv, "--diff") == 0) {
+            diff = true;
+        }
+        else
+        if (::strcmp(*argv, "--diff-format") == 0) {
+            if (argc <= 2) {
+                help("Option --diff-format requires an argument.");
+            }
+            --argc, ++argv;
+            if (!muddoc::Differ::parse(*argv, diffformat)) {
+                help("Option --diff-format requires text or json.");
+            }
+        }
+        else
+        if (::strcmp(*argv, "--jobs") == 0 || ::strcmp(*argv, "-j") == 0) {
+            if (argc <= 2) {
+                help("Option --jobs,-j requires an argument.");
+            }
+            --argc, ++argv;
+            jobs = static_cast<unsigned>(::atoi(*argv));
+            if (jobs == 0) {
+                help("Option --jobs,-j requires a positive number.");
+            }
+        }
+        else
+        if (::strcmp(*argv, "--search-index") == 0 ||
+            ::strcmp(*argv, "--output-index") == 0)
+        {
+            if (argc <= 2) {
+                help("Option --search-index requires an argument.");
+            }
+            --argc, ++argv;
+            searchfile = *argv;
+        }
+        else
+        if (::strcmp(*argv, "--filter") == 0) {
+            if (argc <= 2) {
+                help("Option --filter requires an argument.");
+            }
+            --argc, ++argv;
+            std::string error;
+            if (!expression.parse(*argv, error)) {
+                std::string msg = "Option --filter has an invalid expression: ";
+                help((msg + error).c_str());
+            }
+        }
+        else
+        if (::strcmp(*argv, "--fingerprints") == 0) {
+            fingerprints = true;
+        }
+        else
+        if (::strcmp(*argv, "--symbol") == 0) {
+            if (argc <= 2) {
+                help("Option --symbol requires an argument.");
+            }
+            --argc, ++argv;
+            symbol = *argv;
+            usr = false;
+        }
+        else
+        if (::strcmp(*argv, "--usr") == 0) {
+            if (argc <= 2) {
+                help("Option --usr requires an argument.");
+            }
+            --argc, ++argv;
+            symbol = *argv;
+            usr = true;
+        }
+        else
+        if (::strcmp(*argv, "--symbols-only") == 0) {
+            minimal = true;
+        }
+        else
+        if (::strcmp(*argv, "--warning-level") == 0) {
+            if (argc <= 2) {
+                help("Option --warning-level requires an argument.");
+            }
+            --argc, ++argv;
+            if (!muddoc::Diagnostics::parse(*argv, level)) {
+                help("Option --warning-level requires note, warning or error.");
+            }
+        }
+        else
+        if (::strcmp(*argv, "--warning-format") == 0) {
+            if (argc <= 2) {
+                help("Option --warning-format requires an argument.");
+            }
+            --argc, ++argv;
+            if (!muddoc::Diagnostics::parse(*argv, format)) {
+                help("Option --warning-format requires text, json or sarif.");
+            }
+        }
+        else
+        if (::strcmp(*argv, "--warning-file") == 0) {
+            if (argc <= 2) {
+                help("Option --warning-file requires an argument.");
+            }
+            --argc, ++argv;
+            warningfile = *argv;
+        }
+        else
+        if (::strcmp(*argv, "--lint") == 0) {
+            lint = true;
+        }
+        else
+        if (::strcmp(*argv, "--fail-on") == 0) {
+            if (argc <= 2) {
+                help("Option --fail-on requires an argument.");
+            }
+            --argc, ++argv;
+            if (!muddoc::Diagnostics::parse(*argv, failure)) {
+                help("Option --fail-on requires note, warning or error.");
+            }
+            failing = true;
+        }
+        else
+        if (::strcmp(*argv, "--baseline") == 0) {
+            if (argc <= 2) {
+                help("Option --baseline requires an argument.");
+            }
+            --argc, ++argv;
+            baselinefile = *argv;
+        }
+        else
+        if (::strcmp(*argv, "--stats") == 0) {
+            stats = true;
+        }
+        else
+        if (::strcmp(*argv, "--stats-json") == 0) {
+            if (argc <= 2) {
+                help("Option --stats-json requires an argument.");
+            }
+            --argc, ++argv;
+            statsfile = *argv;
+        }
+        else
+        if (::strcmp(*argv, "--memory") == 0) {
+            memory = true;
+        }
+        else
+        if (::strcmp(*argv, "--count-allocations") == 0) {
+            memory = true;
+            allocations = true;
+        }
+        else
+        if (::strcmp(*argv, "--report-slowest") == 0) {
+            if (argc <= 2) {
+                help("Option --report-slowest requires an argument.");
+            }
+            --argc, ++argv;
+            slowest = static_cast<unsigned>(::atoi(*argv));
+            if (slowest == 0) {
+                help("Option --report-slowest requires a positive number.");
+            }
+        }
+        else
+        if (::strcmp(*argv, "--fast-comments") == 0) {
+            comments = muddoc::Descriptor::Scanned;
+        }
+        else
+        if (::strcmp(*argv, "--check-fast-comments") == 0) {
+            comments = muddoc::Descriptor::Compared;
+        }
+        else
+        if (::strcmp(*argv, "--trace-file") == 0) {
+            if (argc <= 2) {
+                help("Option --trace-file requires an argument.");
+            }
+            --argc, ++argv;
+            tracefile = *argv;
+        }
+        else
+        if (::strcmp(*argv, "--trace-granularity") == 0) {
+            if (argc <= 2) {
+                help("Option --trace-granularity requires an argument.");
+            }
+            --argc, ++argv;
+            granularity = static_cast<unsigned>(::atoi(*argv));
+        }
+        else
         if (::strcmp(*argv, "-I") > 0) {
             clang_args.push_back(*argv);
         }
@@ -144,71 +527,272 @@ main(int argc, char** argv)
         }
     }
 
-    // There should be one argument left.
-    if (argc != 1) {
+    // There should be at least one input file left.
+    if (argc < 1) {
         help("Missing input file");
     }
-    infile = argv[0];
+    std::vector<std::string> infiles(argv, argv + argc);
+    if (diff && (merge || infiles.size() != 2)) {
+        help("Option --diff requires an OLD and a NEW file");
+    }
+    if (jsonfile != nullptr && (merge || diff || minimal || lint)) {
+        help("Option --output-json cannot be used with --merge, --diff, "
+             "--symbols-only or --lint");
+    }
+    if (binaryfile != nullptr && (merge || diff || minimal || lint)) {
+        help("Option --output-binary cannot be used with --merge, --diff, "
+             "--symbols-only or --lint");
+    }
+    if (merge && searchfile != nullptr) {
+        help("Option --search-index cannot be used with --merge");
+    }
+    if (merge && minimal) {
+        help("Option --symbols-only cannot be used with --merge");
+    }
+    if (lint && (merge || minimal)) {
+        help("Option --lint cannot be used with --merge or --symbols-only");
+    }
+    failing = failing || lint;
+    if (merge && symbol != nullptr) {
+        help("Option --symbol or --usr cannot be used with --merge");
+    }
+    if (merge && !expression.empty()) {
+        help("Option --filter cannot be used with --merge");
+    }
+    muddoc::diagnostics().threshold(level);
 
-    // Define the input path and check if it exists
-    std::filesystem::path input = base / infile;
-    if (!std::filesystem::exists(input)) {
-        std::cerr << "Error opening input file " << input
-                  << std::endl;
-        return 1;
+    // Define the input paths and check if they exist
+    for (const auto& infile: infiles) {
+        std::filesystem::path input = base / infile;
+        if (!merge && !diff && !std::filesystem::exists(input)) {
+            std::cerr << "Error opening input file " << input
+                      << std::endl;
+            return 1;
+        }
     }
 
     // If there is no output file defined, use stdout/stderr. Otherwise use the
     // file/stdout.
-    if (outfile == nullptr) {
-        xml = &std::cout;
-        out = &std::cerr;
+    std::ofstream file;
+    std::stringstream buffer;
+    std::ostream* xml = &std::cout;
+    std::ostream* out = &std::cerr;
+    bool buffered = outfile != nullptr && fingerprints && !merge && !diff;
+    if (outfile == nullptr && (jsonfile != nullptr || binaryfile != nullptr)) {
+        xml = nullptr;
+        out = &std::cout;
     }
-    else {
-        xml = new std::ofstream(outfile);
-        if (!*xml) {
+    else
+    if (buffered) {
+        xml = &buffer;
+        out = &std::cout;
+    }
+    else
+    if (outfile != nullptr) {
+        file.open(outfile);
+        if (!file) {
             std::cerr << "Error opening output file " << outfile << std::endl;
             return 1;
         }
+        xml = &file;
         out = &std::cout;
     }
 
-    CXIndex index = clang_createIndex(0, 0);
-    CXTranslationUnit unit = clang_parseTranslationUnit(
-        index, input.c_str(),
-        &(clang_args[0]), clang_args.size(),
-        nullptr, 0,
-        CXTranslationUnit_DetailedPreprocessingRecord);
-    if (unit == nullptr) {
-        std::cerr << "Unable to parse translation unit. Quitting." << std::endl;
-        ::exit(-1);
+    // The JSON is written to its own file, likewise only if it changed.
+    std::ofstream jsonstr;
+    std::stringstream jsonbuffer;
+    std::ostream* json = nullptr;
+    if (jsonfile != nullptr && fingerprints) {
+        json = &jsonbuffer;
+    }
+    else
+    if (jsonfile != nullptr) {
+        jsonstr.open(jsonfile);
+        if (!jsonstr) {
+            std::cerr << "Error opening output file " << jsonfile << std::endl;
+            return 1;
+        }
+        json = &jsonstr;
     }
 
-    // show any warnings that the compiler produced
-    if (diagnostics) {
-        size_t n = clang_getNumDiagnostics(unit);
-        for (int i = 0; i != n; ++i) {
-            CXDiagnostic diag = clang_getDiagnostic(
-                unit, static_cast<unsigned>(i));
-            CXString string = clang_formatDiagnostic(
-                diag, clang_defaultDiagnosticDisplayOptions());
-            std::cerr << "[clang]: " << clang_getCString(string) << std::endl;
-            clang_disposeString(string);
-            clang_disposeDiagnostic(diag);
+    // And so is the binary format, which has to be written unchanged.
+    std::ofstream binarystr;
+    std::stringstream binarybuffer;
+    std::ostream* binary = nullptr;
+    if (binaryfile != nullptr && fingerprints) {
+        binary = &binarybuffer;
+    }
+    else
+    if (binaryfile != nullptr) {
+        binarystr.open(binaryfile, std::ios::binary);
+        if (!binarystr) {
+            std::cerr << "Error opening output file " << binaryfile
+                      << std::endl;
+            return 1;
         }
+        binary = &binarystr;
     }
 
-    // Visit all nodes in the parsing tree
-    muddoc::Visitor visitor(unit);
-    muddoc::FileFilter filter(input);
-    visitor.generate(*xml, filter);
+    // Merge the XML representations of all the input files.
+    if (merge) {
+        muddoc::Merger merger;
+        for (const auto& infile: infiles) {
+            std::ifstream istr(infile);
+            if (!istr) {
+                std::cerr << "Error opening input file " << infile
+                          << std::endl;
+                return 1;
+            }
+            std::string error;
+            if (!merger.merge(istr, infile, error)) {
+                std::cerr << "Error reading input file " << infile << ": "
+                          << error << std::endl;
+                return 1;
+            }
+        }
+        merger.write(*xml);
+        if (!merger.unresolved().empty()) {
+            warn("unresolved-ref",
+                    muddoc::SymbolIndex::summary(merger.unresolved()));
+        }
+        return report(*out, warningfile, format) ? 0 : 1;
+    }
 
-    // Clean-up. If there is an output file, close it by destructing it.
-    clang_disposeTranslationUnit(unit);
-    clang_disposeIndex(index);
-    if (outfile != nullptr) {
-        delete xml;
+    // Compare the symbols of the old and the new XML representation.
+    if (diff) {
+        muddoc::Differ differ;
+        for (size_t i = 0; i < infiles.size(); ++i) {
+            std::ifstream istr(infiles[i]);
+            if (!istr) {
+                std::cerr << "Error opening input file " << infiles[i]
+                          << std::endl;
+                return 1;
+            }
+            std::string error;
+            bool ok = i == 0 ? differ.load(istr, error)
+                             : differ.compare(istr, error);
+            if (!ok) {
+                std::cerr << "Error reading input file " << infiles[i] << ": "
+                          << error << std::endl;
+                return 1;
+            }
+        }
+        differ.write(*xml, diffformat);
+        return 0;
     }
 
-    return 0;
+    // Generate the documentation of all the input files.
+    if (memory && statsfile == nullptr) {
+        stats = true;
+    }
+    if (stats || statsfile != nullptr || slowest > 0) {
+        muddoc::Stats::enable();
+    }
+    muddoc::profile().capacity(slowest);
+    if (memory) {
+        muddoc::Stats::memory(allocations);
+    }
+    muddoc::Descriptor::comments(comments);
+    muddoc::Descriptor::lint(lint);
+    muddoc::Descriptor::fingerprints(fingerprints && !minimal);
+    uint64_t start = muddoc::Stats::wall();
+    muddoc::Processor processor(clang_args, base);
+    muddoc::SearchIndex search;
+    processor.jobs(jobs);
+    processor.clang(diagnostics);
+    processor.minimal(minimal);
+    processor.lint(lint);
+    processor.filter(expression);
+    if (symbol != nullptr) {
+        processor.query(symbol, usr);
+    }
+    if (searchfile != nullptr) {
+        processor.search(&search);
+    }
+    if (tracefile != nullptr) {
+        // Parse on the worker threads themselves, rather than on a thread of
+        // libclang, such that the frontend spans are in the same trace.
+        ::setenv("LIBCLANG_NOTHREADS", "1", 1);
+        llvm::timeTraceProfilerInitialize(granularity, "muddoc");
+        processor.trace(granularity);
+    }
+    bool ok = processor.run(infiles, xml, json, binary, *out);
+    if (buffered && !update(outfile, buffer.str())) {
+        return 1;
+    }
+    if (json == &jsonbuffer && !update(jsonfile, jsonbuffer.str())) {
+        return 1;
+    }
+    if (binary == &binarybuffer && !update(binaryfile, binarybuffer.str())) {
+        return 1;
+    }
+    if (symbol != nullptr && processor.found() == 0) {
+        std::cerr << "Unable to find symbol " << symbol << std::endl;
+        ok = false;
+    }
+
+    // Write the trace of the main thread and all the workers.
+    if (tracefile != nullptr) {
+        llvm::Error error = llvm::timeTraceProfilerWrite(tracefile, "muddoc");
+        llvm::timeTraceProfilerCleanup();
+        if (error) {
+            std::cerr << "Error writing trace file " << tracefile << ": "
+                      << llvm::toString(std::move(error)) << std::endl;
+            return 1;
+        }
+    }
+
+    // Write the search index that was built while generating.
+    if (searchfile != nullptr) {
+        std::ofstream ostr(searchfile);
+        if (!ostr) {
+            std::cerr << "Error opening search index file " << searchfile
+                      << std::endl;
+            return 1;
+        }
+        search.write(ostr);
+    }
+
+    // Drop the known warnings and report the others of all files at once.
+    if (baselinefile != nullptr) {
+        std::ifstream istr(baselinefile);
+        if (!istr) {
+            std::cerr << "Error opening baseline file " << baselinefile
+                      << std::endl;
+            return 1;
+        }
+        muddoc::diagnostics().accept(istr);
+    }
+    if (!report(*out, warningfile, format)) {
+        return 1;
+    }
+    if (failing) {
+        size_t failures = 0;
+        for (int s = failure; s <= muddoc::Diagnostics::Error; ++s) {
+            failures += muddoc::diagnostics().count(
+                    static_cast<muddoc::Diagnostics::Severity>(s));
+        }
+        if (failures > 0) {
+            ok = false;
+        }
+    }
+
+    // Report the statistics of all files.
+    double elapsed = (muddoc::Stats::wall() - start) / 1e9;
+    if (stats) {
+        muddoc::Stats::local().text(*out, elapsed);
+    }
+    if (statsfile != nullptr) {
+        std::ofstream ostr(statsfile);
+        if (!ostr) {
+            std::cerr << "Error opening statistics file " << statsfile
+                      << std::endl;
+            return 1;
+        }
+        muddoc::Stats::local().json(ostr, elapsed);
+    }
+    if (slowest > 0) {
+        muddoc::profile().write(*out);
+    }
+    return ok ? 0 : 1;
 }
@@ -0,0 +1,283 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <clang/AST/DeclTemplate.h>
+#include <llvm/Support/TimeProfiler.h>
+#include "binary.h"
+#include "json.h"
+#include "processor.h"
+#include "sink.h"
+#include "utility.h"
+#include "visitor.h"
+
+namespace muddoc {
+
+Processor::Processor(const std::vector<const char*>& args,
+        const std::filesystem::path& base)
+    : _args(args), _base(base), _jobs(1), _clang(false), _xml(true),
+      _json(false), _binary(false), _documents(0), _search(nullptr),
+      _minimal(false), _lint(false), _usr(false), _found(0), _trace(false),
+      _granularity(0), _threshold(Diagnostics::Note), _slowest(0)
+{
+}
+
+bool
+Processor::run(const std::vector<std::string>& files, std::ostream* xml,
+        std::ostream* json, std::ostream* binary, std::ostream& out)
+{
+    _xml = xml != nullptr;
+    _json = json != nullptr && !_minimal;
+    _binary = binary != nullptr && !_minimal;
+    _documents = 0;
+    _threshold = diagnostics().threshold();
+    _slowest = profile().capacity();
+
+    // Start the workers, they take the files in order from a shared counter.
+    MpscQueue<Result> queue;
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> workers;
+    size_t count = std::max<size_t>(1, std::min<size_t>(_jobs, files.size()));
+    for (size_t i = 0; i < count; ++i) {
+        workers.emplace_back(&Processor::work, this, std::ref(next),
+                std::cref(files), std::ref(queue));
+    }
+
+    // Write the results in the order of the files. A result that completes
+    // early is held until all the results before it have been written.
+    bool ok = true;
+    size_t written = 0;
+    unsigned idle = 0;
+    std::map<size_t, std::unique_ptr<Result>> pending;
+    bool wrap = files.size() > 1 && !_lint;
+    if (wrap && _xml) {
+        *xml << "<docs>";
+    }
+    if (wrap && _json) {
+        *json << "[";
+    }
+    while (written < files.size()) {
+        Result* result = queue.pop();
+        if (result == nullptr) {
+            // Nothing to write yet, back off without taking a lock.
+            if (++idle < 64) {
+                std::this_thread::yield();
+            }
+            else {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+            continue;
+        }
+        idle = 0;
+        pending.emplace(result->sequence, std::unique_ptr<Result>(result));
+        for (auto iter = pending.begin();
+             iter != pending.end() && iter->first == written;
+             iter = pending.erase(iter), ++written)
+        {
+            ok = write(files[written], *iter->second, xml, json, binary, out)
+                    && ok;
+        }
+    }
+    if (wrap && _xml) {
+        *xml << "</docs>";
+    }
+    if (wrap && _json) {
+        *json << "]";
+    }
+    for (auto& worker: workers) {
+        worker.join();
+    }
+    return ok;
+}
+
+void
+Processor::work(std::atomic<size_t>& next,
+        const std::vector<std::string>& files,
+        MpscQueue<Result>& queue) const
+{
+    if (_trace) {
+        llvm::timeTraceProfilerInitialize(_granularity, "muddoc");
+    }
+    CXIndex index = clang_createIndex(0, 0);
+    for (size_t i = next++; i < files.size(); i = next++) {
+        Result* result = new Result();
+        result->sequence = i;
+        result->diagnostics.threshold(_threshold);
+        result->profile.capacity(_slowest);
+        diagnostics(&result->diagnostics);
+        Stats::local(&result->stats);
+        profile(&result->profile);
+        process(index, files[i], *result);
+        profile(nullptr);
+        Stats::local(nullptr);
+        diagnostics(nullptr);
+        queue.push(result);
+    }
+    clang_disposeIndex(index);
+    if (_trace) {
+        llvm::timeTraceProfilerFinishThread();
+    }
+}
+
+void
+Processor::process(CXIndex index, const std::string& file,
+        Result& result) const
+{
+    Stats::Timer timer(Stats::Other);
+    llvm::TimeTraceScope trace("Document", file);
+    std::filesystem::path input = _base / file;
+    CXTranslationUnit unit = nullptr;
+    {
+        Stats::Timer timer(Stats::Parse);
+        llvm::TimeTraceScope trace("Parse", file);
+        unit = clang_parseTranslationUnit(
+            index, input.c_str(),
+            _args.data(), _args.size(),
+            nullptr, 0,
+            CXTranslationUnit_DetailedPreprocessingRecord);
+    }
+    if (unit == nullptr) {
+        return;
+    }
+    result.parsed = true;
+
+    // Capture any warnings that the compiler produced
+    if (_clang) {
+        std::stringstream sstr;
+        unsigned n = clang_getNumDiagnostics(unit);
+        for (unsigned i = 0; i != n; ++i) {
+            CXDiagnostic diag = clang_getDiagnostic(unit, i);
+            sstr << "[clang]: "
+                 << str(clang_formatDiagnostic(
+                        diag, clang_defaultDiagnosticDisplayOptions()))
+                 << "\n";
+            clang_disposeDiagnostic(diag);
+        }
+        result.clang = sstr.str();
+    }
+
+    // Visit all nodes in the parsing tree
+    Visitor visitor(unit);
+    FileFilter files(input);
+    ExpressionFilter expression(files, _expression);
+    const Filter& filter = _expression.empty()
+            ? static_cast<const Filter&>(files) : expression;
+    if (_search != nullptr) {
+        visitor.search(&result.search);
+    }
+    visitor.minimal(_minimal);
+    visitor.lint(_lint);
+    std::stringstream xml;
+    std::stringstream json;
+    std::stringstream binary;
+    if (_minimal) {
+        if (_symbol.empty()) {
+            visitor.generate(xml, filter, file);
+        }
+        else {
+            result.found = visitor.query(xml, filter, file, _symbol, _usr);
+        }
+    }
+    else {
+        // Every format is driven by the same traversal, each into its own
+        // buffer. Only the references to the queried symbols can be resolved,
+        // and only one sink warns about the others.
+        XmlSink xmlsink(xml, _symbol.empty());
+        JsonSink jsonsink(json, _symbol.empty() && !_xml);
+        BinarySink binarysink(binary, _symbol.empty() && !_xml && !_json);
+        Sinks sinks;
+        if (_xml && !_lint) {
+            sinks.add(xmlsink);
+        }
+        if (_json && !_lint) {
+            sinks.add(jsonsink);
+        }
+        if (_binary && !_lint) {
+            sinks.add(binarysink);
+        }
+        if (_symbol.empty()) {
+            visitor.generate(sinks, filter, file);
+        }
+        else {
+            result.found = visitor.query(sinks, filter, file, _symbol, _usr);
+        }
+    }
+    if (!_lint) {
+        result.xml = xml.str();
+        result.json = json.str();
+        result.binary = binary.str();
+    }
+
+    // The locations can only be resolved while the unit exists.
+    result.diagnostics.resolve();
+    Stats::usage(unit);
+    clang_disposeTranslationUnit(unit);
+}
+
+bool
+Processor::write(const std::string& file, Result& result, std::ostream* xml,
+        std::ostream* json, std::ostream* binary, std::ostream& out)
+{
+    Stats::local().add(result.stats);
+    out << result.clang;
+    if (!result.parsed) {
+        std::cerr << "Unable to parse translation unit " << file << std::endl;
+        return false;
+    }
+    {
+        Stats::Timer timer(Stats::Write);
+        llvm::TimeTraceScope trace("Write", file);
+        if (_xml) {
+            *xml << result.xml;
+            Stats::count(Stats::BytesWritten, result.xml.size());
+        }
+        if (_json && !result.json.empty()) {
+            if (_documents++ > 0) {
+                *json << ",";
+            }
+            *json << result.json;
+            Stats::count(Stats::BytesWritten, result.json.size());
+        }
+        if (_binary) {
+            *binary << result.binary;
+            Stats::count(Stats::BytesWritten, result.binary.size());
+        }
+    }
+    _found += result.found;
+    diagnostics().append(result.diagnostics);
+    profile().append(result.profile);
+    if (_search != nullptr) {
+        _search->add(result.search);
+    }
+    return true;
+}
+
+} // namespace muddoc
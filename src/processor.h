@@ -0,0 +1,320 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#ifndef _MUDDOC_PROCESSOR_H_
+#define _MUDDOC_PROCESSOR_H_
+
+#include <atomic>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <clang-c/Index.h>
+#include "expression.h"
+#include "profile.h"
+#include "queue.h"
+#include "search.h"
+#include "stats.h"
+#include "warn_error.h"
+
+namespace muddoc {
+
+/**
+ * @brief Generate the documentation of a set of files.
+ *
+ * @details
+ * Each file is parsed and documented as a separate translation unit by one
+ * of a set of worker threads. A worker renders the documentation, the clang
+ * diagnostics and the muddoc diagnostics of a file into its own result and
+ * pushes it onto a lock-free queue, such that workers never wait on each
+ * other or on the output.
+ *
+ * The calling thread is the single writer. It drains the queue and outputs
+ * the results in the order of the files, regardless of the order in which
+ * they complete. The statistics of the workers are added to the statistics
+ * of the calling thread, and likewise for the most expensive symbols. The
+ * documentation of more than one file is wrapped in a @c docs element:
+ *
+ * @code
+ * <docs>
+ *   <doc file="FILE">...</doc>
+ *   ...
+ * </docs>
+ * @endcode
+ *
+ * The documentation can also be output in JSON, see @c JsonSink, in which
+ * case the documents of more than one file are wrapped in an array, or in
+ * the binary format, see @c BinarySink, in which case the documents of more
+ * than one file follow each other. All
+ * formats are output from a single pass over each translation unit: a worker
+ * drives a sink per format, each into a buffer of its own, and the writer
+ * outputs each buffer to the stream of its format.
+ */
+class Processor
+{
+public:
+    /**
+     * @brief Create a processor.
+     *
+     * @param args The arguments to pass to clang.
+     * @param base The folder that contains the files.
+     */
+    Processor(const std::vector<const char*>& args,
+            const std::filesystem::path& base);
+
+    /**
+     * @brief Set the number of worker threads.
+     *
+     * @param count The number of worker threads, at least one.
+     */
+    void jobs(unsigned count) { _jobs = count > 0 ? count : 1; }
+
+    /**
+     * @brief Set whether to show the clang diagnostics.
+     *
+     * @param show True to output the diagnostics that clang produces.
+     */
+    void clang(bool show) { _clang = show; }
+
+    /**
+     * @brief Set the search index to add the generated symbols to.
+     *
+     * @param index The search index, or @c nullptr to not build one.
+     */
+    void search(SearchIndex* index) { _search = index; }
+
+    /**
+     * @brief Only output a minimal record per symbol.
+     *
+     * @param minimal True to output the symbol records instead of the
+     * documentation, see @c Visitor::minimal.
+     */
+    void minimal(bool minimal) { _minimal = minimal; }
+
+    /**
+     * @brief Only validate the comments, without writing any XML.
+     *
+     * @param lint True to only validate the comments, see @c Visitor::lint.
+     */
+    void lint(bool lint) { _lint = lint; }
+
+    /**
+     * @brief Only document the declarations that match an expression.
+     *
+     * @param expression The expression to match, or an empty expression to
+     * document all declarations.
+     */
+    void filter(const Expression& expression) { _expression = expression; }
+
+    /**
+     * @brief Only document a single symbol.
+     *
+     * @param symbol The qualified name or the USR of the symbol, or an empty
+     * string to document all symbols, see @c Visitor::query.
+     * @param usr True if @p symbol is a USR.
+     */
+    void query(const std::string& symbol, bool usr)
+    {
+        _symbol = symbol;
+        _usr = usr;
+    }
+
+    /**
+     * @brief Get the number of declarations of the symbol that were found.
+     *
+     * @return The number of declarations found in all files, when only a
+     * single symbol is documented.
+     */
+    size_t found() const { return _found; }
+
+    /**
+     * @brief Record trace events in the workers.
+     *
+     * @details
+     * Each worker initialises the LLVM time trace profiler, such that the
+     * spans of the workers, and those of the clang frontend, are part of the
+     * trace. The calling thread needs to initialise the profiler itself and
+     * write the trace once @c run has returned.
+     *
+     * @param granularity The minimum duration of a span in microseconds.
+     */
+    void trace(unsigned granularity)
+    {
+        _trace = true;
+        _granularity = granularity;
+    }
+
+    /**
+     * @brief Generate the documentation.
+     *
+     * @details
+     * Generate the documentation of all files. The muddoc diagnostics are
+     * added to the diagnostics collector of the calling thread, in the order
+     * of the files.
+     *
+     * @param files The files to document, relative to the base folder.
+     * @param xml The stream to output the documentation to.
+     * @param out The stream to output the clang diagnostics to.
+     * @return True if all files have been documented.
+     */
+    bool run(const std::vector<std::string>& files, std::ostream& xml,
+            std::ostream& out)
+    {
+        return run(files, &xml, nullptr, nullptr, out);
+    }
+
+    /**
+     * @brief Generate the documentation in more than one format.
+     *
+     * @details
+     * Generate the documentation of all files, like @c run, in each of the
+     * formats that has a stream. The formats are output from the same parse
+     * and the same traversal of each file. The symbol records of @c minimal
+     * are only output in XML.
+     *
+     * @param files The files to document, relative to the base folder.
+     * @param xml The stream to output the XML to, or @c nullptr.
+     * @param json The stream to output the JSON to, or @c nullptr.
+     * @param binary The stream to output the binary format to, or
+     * @c nullptr.
+     * @param out The stream to output the clang diagnostics to.
+     * @return True if all files have been documented.
+     */
+    bool run(const std::vector<std::string>& files, std::ostream* xml,
+            std::ostream* json, std::ostream* binary, std::ostream& out);
+
+private:
+    /* The outcome of documenting a single file */
+    struct Result: public MpscQueue<Result>::Node
+    {
+        /* The position of the file in the list of files */
+        size_t sequence = 0;
+
+        /* True if the file could be parsed */
+        bool parsed = false;
+
+        /* The documentation in XML */
+        std::string xml;
+
+        /* The documentation in JSON */
+        std::string json;
+
+        /* The documentation in the binary format */
+        std::string binary;
+
+        /* The number of declarations of the queried symbol */
+        size_t found = 0;
+
+        /* The formatted clang diagnostics */
+        std::string clang;
+
+        /* The muddoc diagnostics, with resolved locations */
+        Diagnostics diagnostics;
+
+        /* The symbols for the search index */
+        SearchIndex search;
+
+        /* The statistics of documenting the file */
+        Stats stats;
+
+        /* The most expensive symbols of the file */
+        Profile profile;
+    };
+
+    /* Document files until there are none left */
+    void work(std::atomic<size_t>& next,
+            const std::vector<std::string>& files,
+            MpscQueue<Result>& queue) const;
+
+    /* Document a single file */
+    void process(CXIndex index, const std::string& file,
+            Result& result) const;
+
+    /* Output the result of a single file */
+    bool write(const std::string& file, Result& result, std::ostream* xml,
+            std::ostream* json, std::ostream* binary, std::ostream& out);
+
+    /* The arguments to pass to clang */
+    std::vector<const char*> _args;
+
+    /* The folder that contains the files */
+    std::filesystem::path _base;
+
+    /* The number of worker threads */
+    unsigned _jobs;
+
+    /* True to show the clang diagnostics */
+    bool _clang;
+
+    /* True to output the documentation in XML */
+    bool _xml;
+
+    /* True to output the documentation in JSON */
+    bool _json;
+
+    /* True to output the documentation in the binary format */
+    bool _binary;
+
+    /* The number of JSON documents that have been written */
+    size_t _documents;
+
+    /* The search index to add the symbols to, if any */
+    SearchIndex* _search;
+
+    /* True to only output the symbol records */
+    bool _minimal;
+
+    /* True to only validate the comments */
+    bool _lint;
+
+    /* The expression the declarations have to match */
+    Expression _expression;
+
+    /* The symbol to document, or empty to document all symbols */
+    std::string _symbol;
+
+    /* True if the symbol is a USR */
+    bool _usr;
+
+    /* The number of declarations of the symbol that were found */
+    size_t _found;
+
+    /* True to record trace events in the workers */
+    bool _trace;
+
+    /* The minimum duration of a traced span in microseconds */
+    unsigned _granularity;
+
+    /* The severity threshold of the diagnostics of the workers */
+    Diagnostics::Severity _threshold;
+
+    /* The number of most expensive symbols the workers keep */
+    size_t _slowest;
+};
+
+} // namespace muddoc
+
+#endif /* _MUDDOC_PROCESSOR_H_ */
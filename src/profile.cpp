@@ -0,0 +1,174 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#include <algorithm>
+#include <iomanip>
+#include "profile.h"
+#include "sink.h"
+#include "utility.h"
+
+namespace muddoc {
+
+/* Order the symbols such that the cheapest is on top of the heap */
+static bool
+cheaper(const Profile::Entry& lhs, const Profile::Entry& rhs)
+{
+    return lhs.wall > rhs.wall;
+}
+
+/* The share of a time in the total time, as a percentage */
+static double
+share(uint64_t time, uint64_t total)
+{
+    return total > 0 ? 100.0 * time / total : 0.0;
+}
+
+/* ==== Profile::Scope ==== */
+
+Profile::Scope::Scope(const CXCursor& cursor, const char* kind)
+    : _profile(profile().capacity() > 0 ? &profile() : nullptr),
+      _entry(), _start(0), _sink(nullptr), _position(0)
+{
+    if (_profile == nullptr) {
+        return;
+    }
+
+    // The location can only be resolved while the translation unit exists.
+    CXFile file;
+    clang_getSpellingLocation(clang_getCursorLocation(cursor), &file,
+            &_entry.line, nullptr, nullptr);
+    _entry.file = str(clang_getFileName(file));
+    _entry.kind = kind;
+    Stats::local().snapshot(_entry.phases);
+    _start = Stats::wall();
+}
+
+Profile::Scope::~Scope()
+{
+    if (_profile == nullptr) {
+        return;
+    }
+    _entry.wall = Stats::wall() - _start;
+    uint64_t phases[Stats::Phases];
+    Stats::local().snapshot(phases);
+    for (int i = 0; i < Stats::Phases; ++i) {
+        _entry.phases[i] = phases[i] - _entry.phases[i];
+    }
+    if (_sink != nullptr) {
+        _entry.bytes = _sink->size() - _position;
+    }
+    _profile->add(_entry);
+}
+
+void
+Profile::Scope::output(const Sink& sink, const std::string& name)
+{
+    if (_profile != nullptr) {
+        _entry.name = name;
+        _sink = &sink;
+        _position = sink.size();
+    }
+}
+
+/* ==== Profile ==== */
+
+Profile::Profile(size_t capacity)
+    : _capacity(capacity)
+{
+}
+
+void
+Profile::add(const Entry& entry)
+{
+    if (_heap.size() < _capacity) {
+        _heap.push_back(entry);
+        std::push_heap(_heap.begin(), _heap.end(), cheaper);
+    }
+    else
+    if (!_heap.empty() && entry.wall > _heap.front().wall) {
+        std::pop_heap(_heap.begin(), _heap.end(), cheaper);
+        _heap.back() = entry;
+        std::push_heap(_heap.begin(), _heap.end(), cheaper);
+    }
+}
+
+void
+Profile::append(const Profile& other)
+{
+    for (const auto& entry: other._heap) {
+        add(entry);
+    }
+}
+
+void
+Profile::write(std::ostream& ostr) const
+{
+    std::vector<Entry> entries(_heap);
+    std::sort(entries.begin(), entries.end(), cheaper);
+    ostr << std::fixed << std::setprecision(1)
+         << "muddoc slowest symbols\n"
+         << "  " << std::right << std::setw(10) << "wall (ms)"
+         << std::setw(12) << "bytes"
+         << std::setw(10) << "comments" << std::setw(8) << "pretty"
+         << std::setw(11) << "serialize" << "  "
+         << std::left << std::setw(12) << "kind" << "symbol\n";
+    for (const auto& entry: entries) {
+        // Comment rendering includes looking up and parsing the comments,
+        // serialization includes escaping the text.
+        uint64_t comments =
+            entry.phases[Stats::Comments] + entry.phases[Stats::Render];
+        uint64_t pretty = entry.phases[Stats::Pretty];
+        uint64_t serialize =
+            entry.phases[Stats::Serialize] + entry.phases[Stats::Escape];
+        ostr << "  " << std::right << std::setprecision(3) << std::setw(10)
+             << entry.wall / 1e6 << std::setw(12) << entry.bytes
+             << std::setprecision(1)
+             << std::setw(9) << share(comments, entry.wall) << "%"
+             << std::setw(7) << share(pretty, entry.wall) << "%"
+             << std::setw(10) << share(serialize, entry.wall) << "%" << "  "
+             << std::left << std::setw(12) << entry.kind << entry.name
+             << " (" << entry.file << ":" << entry.line << ")\n";
+    }
+    ostr << std::defaultfloat;
+}
+
+/* The profile of the current thread, if it is not the process profile */
+static thread_local Profile* current = nullptr;
+
+Profile&
+profile()
+{
+    static Profile instance;
+    return current != nullptr ? *current : instance;
+}
+
+void
+profile(Profile* profile)
+{
+    current = profile;
+}
+
+} // namespace muddoc
@@ -0,0 +1,215 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#ifndef _MUDDOC_PROFILE_H_
+#define _MUDDOC_PROFILE_H_
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <clang-c/Index.h>
+#include "stats.h"
+
+namespace muddoc {
+
+/** Forward declaration */
+class Sink;
+
+/**
+ * @brief The most expensive symbols of the documentation generation.
+ *
+ * @details
+ * The wall clock time and the output size are measured for the subtree of
+ * every namespace, class and method that is documented. The time includes
+ * that of all nested symbols and is split into the phases of the statistics,
+ * such that the share of comment rendering, pretty-printing and
+ * serialization of a symbol is known.
+ *
+ * Only the most expensive symbols are kept, in a heap that is bounded by the
+ * capacity of the profile. A capacity of zero disables the profile, in which
+ * case measuring a symbol is a single branch.
+ */
+class Profile
+{
+public:
+    /**
+     * @brief The cost of a single symbol.
+     */
+    struct Entry
+    {
+        /** The kind of symbol */
+        const char* kind;
+
+        /** The qualified name of the symbol */
+        std::string name;
+
+        /** The file and line that declares the symbol */
+        std::string file;
+        unsigned line;
+
+        /** The wall clock time of the subtree in nanoseconds */
+        uint64_t wall;
+
+        /** The wall clock time of each phase in nanoseconds */
+        uint64_t phases[Stats::Phases];
+
+        /** The number of bytes of output of the subtree */
+        uint64_t bytes;
+    };
+
+    /**
+     * @brief Measure a symbol for the lifetime of the object.
+     *
+     * @details
+     * The measurement starts when the object is created and ends when it is
+     * destructed, after which the symbol is added to the profile of the
+     * thread. The output of the symbol is measured from the stream that is
+     * passed to @c output.
+     */
+    class Scope
+    {
+    public:
+        /**
+         * @brief Start measuring a symbol.
+         *
+         * @param cursor The declaration of the symbol.
+         * @param kind The kind of symbol, a static string.
+         */
+        Scope(const CXCursor& cursor, const char* kind);
+
+        /**
+         * @brief Stop measuring the symbol and add it to the profile.
+         */
+        ~Scope();
+
+        /**
+         * @brief Set the sink that the symbol is output to.
+         *
+         * @param sink The sink that the symbol is output to next, before
+         * any of it, including its members, has been output.
+         * @param name The qualified name of the symbol.
+         */
+        void output(const Sink& sink, const std::string& name);
+
+        /** Non-copyable */
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        /* The profile to add to, or nullptr if not enabled */
+        Profile* _profile;
+
+        /* The measurement so far */
+        Entry _entry;
+
+        /* The wall clock time at the start */
+        uint64_t _start;
+
+        /* The sink the symbol is output to and its size at the start */
+        const Sink* _sink;
+        uint64_t _position;
+    };
+
+    /**
+     * @brief Create a profile.
+     *
+     * @param capacity The number of symbols to keep.
+     */
+    Profile(size_t capacity = 0);
+
+    /**
+     * @brief Set the number of symbols to keep.
+     *
+     * @param capacity The number of symbols to keep, zero to disable.
+     */
+    void capacity(size_t capacity) { _capacity = capacity; }
+
+    /**
+     * @brief Get the number of symbols to keep.
+     *
+     * @return The number of symbols to keep.
+     */
+    size_t capacity() const { return _capacity; }
+
+    /**
+     * @brief Add a symbol.
+     *
+     * @details
+     * The symbol is only kept if it is among the most expensive symbols.
+     *
+     * @param entry The cost of the symbol.
+     */
+    void add(const Entry& entry);
+
+    /**
+     * @brief Add the symbols of another profile.
+     *
+     * @param other The profile to add the symbols of.
+     */
+    void append(const Profile& other);
+
+    /**
+     * @brief Output the symbols as a human readable table.
+     *
+     * @details
+     * The symbols are output from the most to the least expensive.
+     *
+     * @param ostr The stream to output to.
+     */
+    void write(std::ostream& ostr) const;
+
+private:
+    /* The number of symbols to keep */
+    size_t _capacity;
+
+    /* The most expensive symbols, with the cheapest on top */
+    std::vector<Entry> _heap;
+};
+
+/**
+ * @brief Get the profile.
+ *
+ * @details
+ * Each thread has its own profile, such that threads never contend when
+ * measuring symbols. Unless another profile has been set for the thread,
+ * this is the profile of the process.
+ *
+ * @return The profile that the symbols of this thread are added to.
+ */
+Profile& profile();
+
+/**
+ * @brief Set the profile of this thread.
+ *
+ * @param profile The profile to add the symbols of this thread to, or
+ * @c nullptr to use the profile of the process.
+ */
+void profile(Profile* profile);
+
+} // namespace muddoc
+
+#endif /* _MUDDOC_PROFILE_H_ */
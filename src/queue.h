@@ -0,0 +1,149 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#ifndef _MUDDOC_QUEUE_H_
+#define _MUDDOC_QUEUE_H_
+
+#include <atomic>
+
+namespace muddoc {
+
+/**
+ * @brief Lock-free multiple producer, single consumer queue.
+ *
+ * @details
+ * An intrusive queue after Dmitry Vyukov's MPSC node-based design. Any number
+ * of threads can push items concurrently, while a single thread pops them.
+ * A push is a single atomic exchange and never waits on another thread. A
+ * pop never blocks either, but it may return @c nullptr while a push is in
+ * progress; the consumer then simply tries again.
+ *
+ * The items are not owned by the queue. An item type derives from
+ * @c MpscQueue<T>::Node:
+ *
+ * @code
+ * struct Result: public MpscQueue<Result>::Node { ... };
+ * @endcode
+ *
+ * @tparam T The type of the items in the queue.
+ */
+template <typename T>
+class MpscQueue
+{
+public:
+    /**
+     * @brief The link of an item in the queue.
+     */
+    struct Node
+    {
+        /** The next item in the queue */
+        std::atomic<Node*> next { nullptr };
+    };
+
+    /**
+     * @brief Create an empty queue.
+     */
+    MpscQueue()
+        : _head(&_stub), _tail(&_stub)
+    {
+    }
+
+    /** Non-copyable */
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /**
+     * @brief Add an item to the end of the queue.
+     *
+     * @details
+     * This may be called by any thread.
+     *
+     * @param item The item to add.
+     */
+    void push(T* item) { push(static_cast<Node*>(item)); }
+
+    /**
+     * @brief Remove the item at the front of the queue.
+     *
+     * @details
+     * This may only be called by the consumer thread.
+     *
+     * @return The item at the front of the queue, or @c nullptr if the queue
+     * is empty or the next item is still being pushed.
+     */
+    T* pop()
+    {
+        Node* tail = _tail;
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (tail == &_stub) {
+            if (next == nullptr) {
+                return nullptr;
+            }
+            _tail = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if (next != nullptr) {
+            _tail = next;
+            return static_cast<T*>(tail);
+        }
+
+        // The tail is the last item. Unless a push is in progress, put the
+        // stub behind it such that the tail can be taken off.
+        if (tail != _head.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        push(&_stub);
+        next = tail->next.load(std::memory_order_acquire);
+        if (next != nullptr) {
+            _tail = next;
+            return static_cast<T*>(tail);
+        }
+        return nullptr;
+    }
+
+private:
+    /* Link a node to the end of the queue */
+    void push(Node* node)
+    {
+        node->next.store(nullptr, std::memory_order_relaxed);
+        Node* prev = _head.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    /* The last node in the queue, written by the producers */
+    std::atomic<Node*> _head;
+
+    /* The first node in the queue, only used by the consumer */
+    Node* _tail;
+
+    /* The placeholder node that keeps the queue non-empty */
+    Node _stub;
+};
+
+} // namespace muddoc
+
+#endif /* _MUDDOC_QUEUE_H_ */
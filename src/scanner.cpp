@@ -0,0 +1,477 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#include <algorithm>
+#include "scanner.h"
+
+namespace muddoc {
+
+/* Characters that are escaped by a preceding backslash or at sign */
+static const std::string_view escaped = "\\@&$#<>%\".:";
+
+/* Characters that start a new token in a paragraph */
+static const std::string_view specials = "\n\r\\@&<";
+
+/* Verify if a character is a letter */
+static bool
+letter(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+/* Verify if a character is a letter or a digit */
+static bool
+alphanumeric(char c)
+{
+    return letter(c) || (c >= '0' && c <= '9');
+}
+
+/* Verify if a character is horizontal whitespace */
+static bool
+horizontal(char c)
+{
+    return c == ' ' || c == '\t' || c == '\f' || c == '\v';
+}
+
+/* Verify if a character is whitespace */
+static bool
+whitespace(char c)
+{
+    return horizontal(c) || c == '\n' || c == '\r';
+}
+
+/* Verify if a text consists of whitespace only */
+static bool
+whitespace(std::string_view text)
+{
+    return std::all_of(text.begin(), text.end(),
+            [](char c) { return whitespace(c); });
+}
+
+/* Skip a newline, which may be a CR-LF pair */
+static const char*
+newline(const char* ptr, const char* end)
+{
+    if (ptr != end && *ptr == '\r') {
+        ++ptr;
+        if (ptr != end && *ptr == '\n') {
+            ++ptr;
+        }
+    }
+    else
+    if (ptr != end && *ptr == '\n') {
+        ++ptr;
+    }
+    return ptr;
+}
+
+/* Skip the decoration at the start of a line, being whitespace and a '*' */
+static const char*
+decoration(const char* ptr, const char* end)
+{
+    const char* next = ptr;
+    while (next != end && horizontal(*next)) {
+        ++next;
+    }
+    return next != end && *next == '*' ? next + 1 : ptr;
+}
+
+/* ========================================================================
+ * CommentScanner
+ * ======================================================================== */
+
+const CommentScanner::Command CommentScanner::_commands[] = {
+    { "brief",   true,  Block::Brief },
+    { "details", true,  Block::Details },
+    { "param",   true,  Block::Param },
+    { "tparam",  true,  Block::TParam },
+    { "return",  true,  Block::Return },
+    { "returns", true,  Block::Return },
+    { "see",     true,  Block::See },
+    { "sa",      true,  Block::See },
+    { "seealso", true,  Block::See },
+    { "a",       false, Inline::Emphasis },
+    { "b",       false, Inline::Bold },
+    { "c",       false, Inline::Code },
+    { "e",       false, Inline::Emphasis },
+    { "em",      false, Inline::Emphasis },
+    { "p",       false, Inline::Code },
+    { "ref",     false, Inline::Reference }
+};
+
+bool
+CommentScanner::scan(const char* begin, const char* end)
+{
+    _tokens.clear();
+    _blocks.clear();
+    _index = 0;
+    if (!lex(begin, end)) {
+        return false;
+    }
+
+    /* Parse the blocks, skipping the newlines in between. */
+    while (token().kind != Token::End) {
+        if (token().kind == Token::Newline) {
+            ++_index;
+        }
+        else
+        if (!content()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool
+CommentScanner::lex(const char* ptr, const char* end)
+{
+    /* Only a single JavaDoc or Qt style block comment is supported. */
+    std::string_view raw(ptr, end - ptr);
+    if (raw.size() < 5 || raw.substr(0, 2) != "/*"
+            || (raw[2] != '*' && raw[2] != '!')
+            || raw.find("*/") != raw.size() - 2) {
+        return false;
+    }
+    ptr += 3;
+    end -= 2;
+
+    /* Neither are trailing comments. */
+    if (ptr != end && *ptr == '<') {
+        return false;
+    }
+
+    while (ptr != end) {
+        switch (*ptr) {
+            case '\n':
+            case '\r':
+                /* Any decoration of the next line is not part of the text. */
+                push(Token::Newline);
+                ptr = decoration(newline(ptr, end), end);
+                break;
+            case '\\':
+            case '@':
+                if (!command(ptr, end)) {
+                    return false;
+                }
+                break;
+            case '&':
+                /* A character reference is not supported. */
+                if (ptr + 1 != end && (letter(ptr[1]) || ptr[1] == '#')) {
+                    return false;
+                }
+                push(Token::Text, ptr, ptr + 1);
+                ++ptr;
+                break;
+            case '<':
+                /* An HTML tag is not supported. */
+                if (ptr + 1 != end && (letter(ptr[1]) || ptr[1] == '/')) {
+                    return false;
+                }
+                push(Token::Text, ptr, ptr + 1);
+                ++ptr;
+                break;
+            default: {
+                /* Plain text up to the next special character. */
+                size_t length = std::string_view(ptr, end - ptr)
+                        .find_first_of(specials);
+                const char* next =
+                        length == std::string_view::npos ? end : ptr + length;
+                push(Token::Text, ptr, next);
+                ptr = next;
+                break;
+            }
+        }
+    }
+
+    /* The end of the comment ends the last line. */
+    push(Token::Newline);
+    push(Token::End);
+    return true;
+}
+
+bool
+CommentScanner::command(const char*& ptr, const char* end)
+{
+    const char marker = *ptr;
+    const char* begin = ++ptr;
+
+    /* A marker at the end is text. */
+    if (ptr == end) {
+        push(Token::Text, begin - 1, ptr);
+        return true;
+    }
+
+    /* An escaped character is text, without the marker. */
+    if (escaped.find(*ptr) != std::string_view::npos) {
+        ++ptr;
+        if (*begin == ':' && ptr != end && *ptr == ':') {
+            ++ptr;
+        }
+        push(Token::Text, begin, ptr);
+        return true;
+    }
+
+    /* A marker that is not followed by a name is text. */
+    if (!letter(*ptr)) {
+        push(Token::Text, begin - 1, ptr);
+        return true;
+    }
+    while (ptr != end && alphanumeric(*ptr)) {
+        ++ptr;
+    }
+    std::string_view name(begin, ptr - begin);
+    if (name == "code") {
+        return verbatim(ptr, end, marker);
+    }
+    for (const Command& command : _commands) {
+        if (name == command.name) {
+            push(Token::Command, begin - 1, ptr);
+            _tokens.back().command = &command;
+            return true;
+        }
+    }
+
+    /* Any other command is not supported. */
+    return false;
+}
+
+bool
+CommentScanner::verbatim(const char*& ptr, const char* end, char marker)
+{
+    const std::string close = std::string(1, marker) + "endcode";
+    push(Token::VerbatimBegin);
+
+    /* A newline right after the command does not start an empty line. */
+    bool first = true;
+    if (ptr != end && (*ptr == '\n' || *ptr == '\r')) {
+        ptr = newline(ptr, end);
+        first = false;
+    }
+    while (true) {
+        /* An unterminated block is not supported. */
+        if (!first) {
+            ptr = decoration(ptr, end);
+            if (ptr == end) {
+                return false;
+            }
+        }
+        first = false;
+
+        /* The line is verbatim, up to a closing command. */
+        const char* eol = std::find_if(ptr, end,
+                [](char c) { return c == '\n' || c == '\r'; });
+        std::string_view line(ptr, eol - ptr);
+        size_t pos = line.find(close);
+        if (pos == std::string_view::npos) {
+            push(Token::VerbatimLine, ptr, eol);
+            ptr = newline(eol, end);
+        }
+        else
+        if (pos == 0) {
+            ptr += close.size();
+            push(Token::VerbatimEnd);
+            return true;
+        }
+        else
+        if (whitespace(line.substr(0, pos))) {
+            ptr += pos;
+            first = true;
+        }
+        else {
+            push(Token::VerbatimLine, ptr, ptr + pos);
+            ptr += pos;
+        }
+    }
+}
+
+void
+CommentScanner::push(Token::Kind kind, const char* begin, const char* end)
+{
+    _tokens.push_back(Token{ kind,
+            std::string_view(begin, end - begin), nullptr });
+}
+
+bool
+CommentScanner::content()
+{
+    if (token().kind == Token::VerbatimBegin) {
+        verbatim();
+        return true;
+    }
+    if (ahead()) {
+        return block();
+    }
+    _blocks.emplace_back();
+    _blocks.back().kind = Block::Paragraph;
+    paragraph(_blocks.back().inlines);
+    return true;
+}
+
+bool
+CommentScanner::block()
+{
+    Block block;
+    block.kind = Block::Kind(token().command->kind);
+    bool param = block.kind == Block::Param || block.kind == Block::TParam;
+    ++_index;
+
+    /* A block command ahead leaves this command without arguments. */
+    if (ahead()) {
+        if (param) {
+            return false;
+        }
+        _blocks.push_back(std::move(block));
+        return true;
+    }
+
+    /* The parameter name is mandatory. A direction and the variadic
+     * parameter are not supported. */
+    if (param) {
+        if (!word(block.name) || block.name[0] == '['
+                || block.name == "...") {
+            return false;
+        }
+    }
+
+    /* A block command ahead, possibly on the next line, leaves this
+     * command with an empty paragraph. */
+    bool empty = ahead();
+    if (!empty && token().kind == Token::Newline) {
+        ++_index;
+        empty = ahead();
+        --_index;
+    }
+    if (!empty) {
+        paragraph(block.inlines);
+    }
+    _blocks.push_back(std::move(block));
+    return true;
+}
+
+void
+CommentScanner::paragraph(std::vector<Inline>& inlines)
+{
+    while (true) {
+        const Token& current = token();
+        switch (current.kind) {
+            case Token::Text:
+                /* Text that is only whitespace is dropped. */
+                if (!whitespace(current.text)) {
+                    inlines.push_back(Inline{ Inline::Text,
+                            std::string(current.text) });
+                }
+                ++_index;
+                break;
+            case Token::Command: {
+                /* A block command ends the paragraph. */
+                if (current.command->block) {
+                    return;
+                }
+                Inline::Kind kind = Inline::Kind(current.command->kind);
+                ++_index;
+                std::string arg;
+                word(arg);
+                inlines.push_back(Inline{ kind, arg });
+                break;
+            }
+            case Token::Newline: {
+                /* An empty line, possibly with whitespace, ends the
+                 * paragraph. */
+                size_t index = ++_index;
+                if (token().kind == Token::Text && whitespace(token().text)) {
+                    ++_index;
+                }
+                if (token().kind == Token::Newline) {
+                    ++_index;
+                    return;
+                }
+                if (token().kind == Token::End) {
+                    return;
+                }
+                _index = index;
+                break;
+            }
+            default:
+                /* A code block or the end of the comment. */
+                return;
+        }
+    }
+}
+
+void
+CommentScanner::verbatim()
+{
+    Block block;
+    block.kind = Block::Verbatim;
+    for (++_index; token().kind == Token::VerbatimLine; ++_index) {
+        block.lines.emplace_back(token().text);
+    }
+
+    /* Skip the closing command, the lexer only accepts terminated blocks. */
+    ++_index;
+    _blocks.push_back(std::move(block));
+}
+
+bool
+CommentScanner::word(std::string& word)
+{
+    /* The word may span adjacent text tokens, after leading whitespace. */
+    size_t index = _index;
+    size_t offset = 0;
+    word.clear();
+    while (_tokens[index].kind == Token::Text) {
+        std::string_view text = _tokens[index].text;
+        if (word.empty()) {
+            while (offset != text.size() && whitespace(text[offset])) {
+                ++offset;
+            }
+        }
+        while (offset != text.size() && !whitespace(text[offset])) {
+            word += text[offset++];
+        }
+        if (offset != text.size()) {
+            break;
+        }
+        ++index;
+        offset = 0;
+    }
+    if (word.empty()) {
+        return false;
+    }
+
+    /* Leave the rest of a partially consumed token. */
+    _index = index;
+    _tokens[index].text.remove_prefix(offset);
+    return true;
+}
+
+bool
+CommentScanner::ahead() const
+{
+    return token().kind == Token::Command && token().command->block;
+}
+
+} // namespace muddoc
@@ -0,0 +1,185 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#ifndef _MUDDOC_SCANNER_H_
+#define _MUDDOC_SCANNER_H_
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace muddoc {
+
+/**
+ * @brief Single-pass scanner of the raw text of a documentation comment.
+ *
+ * @details
+ * Parses the subset of doxygen that is rendered by muddoc straight from the
+ * raw comment text, without building the comment AST of clang. The supported
+ * block commands are @c brief, @c details, @c param, @c tparam, @c return,
+ * @c see and @c code, and the supported inline commands are @c a, @c b,
+ * @c c, @c e, @c em, @c p and @c ref.
+ *
+ * The comment is split into paragraphs and block commands in exactly the
+ * same way as the clang comment parser does, down to the text fragments and
+ * the whitespace they hold, such that rendering the blocks results in the
+ * same XML as rendering the clang comment AST.
+ *
+ * Anything outside the subset, like HTML tags, character references, other
+ * commands and line comments, makes the scan fail. The caller should then
+ * fall back to the clang comment parser.
+ */
+class CommentScanner
+{
+public:
+    /**
+     * @brief A fragment of the text of a paragraph.
+     */
+    struct Inline
+    {
+        /** The kind of fragment */
+        enum Kind {
+            Text,           /**< Plain text */
+            Code,           /**< The argument of @c c or @c p */
+            Bold,           /**< The argument of @c b */
+            Emphasis,       /**< The argument of @c a, @c e or @c em */
+            Reference       /**< The argument of @c ref */
+        } kind;
+
+        /** The text, or the argument of the command */
+        std::string text;
+    };
+
+    /**
+     * @brief A paragraph or a block command with its paragraph.
+     */
+    struct Block
+    {
+        /** The kind of block */
+        enum Kind {
+            Paragraph,      /**< A paragraph of text */
+            Brief,          /**< A @c brief command */
+            Details,        /**< A @c details command */
+            Param,          /**< A @c param command */
+            TParam,         /**< A @c tparam command */
+            Return,         /**< A @c return or @c returns command */
+            See,            /**< A @c see, @c sa or @c seealso command */
+            Verbatim        /**< A @c code block */
+        } kind;
+
+        /** The parameter name of a @c param or @c tparam command */
+        std::string name;
+
+        /** The text of the paragraph */
+        std::vector<Inline> inlines;
+
+        /** The lines of a @c code block */
+        std::vector<std::string> lines;
+    };
+
+    /**
+     * @brief Scan a raw comment.
+     *
+     * @details
+     * Only a single block comment in JavaDoc or Qt style can be scanned. The
+     * text is not copied, except for the parts that end up in the blocks.
+     *
+     * @param begin The start of the raw comment text.
+     * @param end The end of the raw comment text.
+     * @return True if the comment has been scanned, false if it is not
+     * supported.
+     */
+    bool scan(const char* begin, const char* end);
+
+    /**
+     * @brief Get the blocks of the scanned comment.
+     * @return The blocks in the order of the comment.
+     */
+    const std::vector<Block>& blocks() const { return _blocks; }
+
+private:
+    /* A command of the supported subset */
+    struct Command
+    {
+        /* The name of the command */
+        const char* name;
+
+        /* True if it is a block command, false if an inline command */
+        bool block;
+
+        /* The kind of block or inline */
+        int kind;
+    };
+
+    /* A lexical token, as produced by the clang comment lexer */
+    struct Token
+    {
+        enum Kind {
+            Text, Newline, Command, VerbatimBegin, VerbatimLine, VerbatimEnd,
+            End
+        } kind;
+
+        /* The text, pointing into the raw comment */
+        std::string_view text;
+
+        /* The command, for a command token */
+        const struct Command* command;
+    };
+
+    /* Lexical analysis of the comment */
+    bool lex(const char* ptr, const char* end);
+    bool command(const char*& ptr, const char* end);
+    bool verbatim(const char*& ptr, const char* end, char marker);
+    void push(Token::Kind kind, const char* begin = nullptr,
+            const char* end = nullptr);
+
+    /* Parsing of the tokens into blocks */
+    bool content();
+    bool block();
+    void paragraph(std::vector<Inline>& inlines);
+    void verbatim();
+    bool word(std::string& word);
+    bool ahead() const;
+
+    /* The current token */
+    const Token& token() const { return _tokens[_index]; }
+
+    /* The supported commands */
+    static const Command _commands[];
+
+    /* The tokens of the comment, ending with an End token */
+    std::vector<Token> _tokens;
+
+    /* The index of the current token */
+    size_t _index = 0;
+
+    /* The blocks of the comment */
+    std::vector<Block> _blocks;
+};
+
+} // namespace muddoc
+
+#endif /* _MUDDOC_SCANNER_H_ */
@@ -0,0 +1,176 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#include <algorithm>
+#include <cctype>
+#include "search.h"
+#include "utility.h"
+
+namespace muddoc {
+
+void
+SearchIndex::add(const std::string& name, const std::string& qualified,
+        const std::string& kind, const std::string& usr,
+        const std::string& brief)
+{
+    if (name.empty()) {
+        return;
+    }
+    if (!usr.empty() && !_index.emplace(usr, _symbols.size()).second) {
+        return;
+    }
+    size_t id = _symbols.size();
+    std::string key = name;
+    std::transform(key.begin(), key.end(), key.begin(),
+            [](unsigned char ch) { return std::tolower(ch); });
+    _symbols.push_back({ name, qualified, kind, usr, key });
+    for (const auto& token: tokenize(brief)) {
+        auto& ids = _tokens[token];
+        if (ids.empty() || ids.back() != id) {
+            ids.push_back(id);
+        }
+    }
+}
+
+void
+SearchIndex::add(const SearchIndex& other)
+{
+    // Add the symbols and map their ids in the other index to the ids in this
+    // index, where a symbol that is already present maps to nothing.
+    static const size_t none = size_t(-1);
+    std::vector<size_t> ids(other._symbols.size(), none);
+    for (size_t i = 0; i < other._symbols.size(); ++i) {
+        const Symbol& symbol = other._symbols[i];
+        if (!symbol.usr.empty()
+                && !_index.emplace(symbol.usr, _symbols.size()).second) {
+            continue;
+        }
+        ids[i] = _symbols.size();
+        _symbols.push_back(symbol);
+    }
+
+    // The mapped ids are increasing, so the ids of each token stay sorted.
+    for (const auto& token: other._tokens) {
+        std::vector<size_t>* mapped = nullptr;
+        for (auto id: token.second) {
+            if (ids[id] == none) {
+                continue;
+            }
+            if (mapped == nullptr) {
+                mapped = &_tokens[token.first];
+            }
+            mapped->push_back(ids[id]);
+        }
+    }
+}
+
+void
+SearchIndex::write(std::ostream& ostr) const
+{
+    // Sort the symbols and map the order in which they were added to their
+    // position in the output.
+    std::vector<size_t> order(_symbols.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [this](size_t lhs, size_t rhs) {
+        const Symbol& l = _symbols[lhs];
+        const Symbol& r = _symbols[rhs];
+        return l.key != r.key ? l.key < r.key : l.qualified < r.qualified;
+    });
+    std::vector<size_t> position(order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        position[order[i]] = i;
+    }
+
+    ostr << "{\"symbols\":[";
+    for (size_t i = 0; i < order.size(); ++i) {
+        const Symbol& symbol = _symbols[order[i]];
+        ostr << (i > 0 ? ",[" : "[")
+             << quote(symbol.name) << ","
+             << quote(symbol.qualified) << ","
+             << quote(symbol.kind) << ","
+             << quote(symbol.usr) << "]";
+    }
+    ostr << "],\"tokens\":[";
+    bool first = true;
+    for (const auto& token: _tokens) {
+        std::vector<size_t> ids;
+        ids.reserve(token.second.size());
+        for (auto id: token.second) {
+            ids.push_back(position[id]);
+        }
+        std::sort(ids.begin(), ids.end());
+        ostr << (first ? "[" : ",[") << quote(token.first) << ",[";
+        for (size_t i = 0; i < ids.size(); ++i) {
+            ostr << (i > 0 ? "," : "") << ids[i];
+        }
+        ostr << "]]";
+        first = false;
+    }
+    ostr << "]}" << std::endl;
+}
+
+std::vector<std::string>
+SearchIndex::tokenize(const std::string& xml)
+{
+    // Remove the markup, leaving the text.
+    std::string text;
+    bool tag = false;
+    for (auto ch: xml) {
+        if (ch == '<') {
+            tag = true;
+            text += ' ';
+        }
+        else
+        if (ch == '>') {
+            tag = false;
+        }
+        else
+        if (!tag) {
+            text += ch;
+        }
+    }
+    text = unescape(text);
+
+    // Split the text in words of letters, digits and underscores.
+    std::vector<std::string> tokens;
+    std::string token;
+    for (size_t i = 0; i <= text.size(); ++i) {
+        unsigned char ch = i < text.size() ? text[i] : ' ';
+        if (std::isalnum(ch) || ch == '_') {
+            token += std::tolower(ch);
+            continue;
+        }
+        if (token.size() > 1) {
+            tokens.push_back(token);
+        }
+        token.clear();
+    }
+    return tokens;
+}
+
+} // namespace muddoc
@@ -0,0 +1,138 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#ifndef _MUDDOC_SEARCH_H_
+#define _MUDDOC_SEARCH_H_
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace muddoc {
+
+/**
+ * @brief Static search index of the documented symbols.
+ *
+ * @details
+ * The search index is built from the descriptors while the documentation is
+ * generated and is written as a compact JSON document that a browser can
+ * query without downloading and tokenising the documentation itself:
+ *
+ * @code
+ * {
+ *   "symbols": [ [ "NAME", "QUALIFIED", "KIND", "USR" ], ... ],
+ *   "tokens": [ [ "TOKEN", [ ID, ... ] ], ... ]
+ * }
+ * @endcode
+ *
+ * The @c symbols array is sorted by the lower-case name, and then by the
+ * qualified name, such that a prefix query is a binary search. The @c tokens
+ * array is an inverted index of the words in the brief descriptions, sorted
+ * by token, where each token refers to the symbols by their index in the
+ * @c symbols array. Tokens are lower-case and at least two characters long.
+ */
+class SearchIndex
+{
+public:
+    /**
+     * @brief Create an empty index.
+     */
+    SearchIndex() = default;
+
+    /**
+     * @brief Add a symbol.
+     *
+     * @details
+     * Add a symbol and the words of its brief description to the index. A
+     * symbol that is added more than once, like a namespace that is
+     * re-opened, is only indexed once.
+     *
+     * @param name The name of the symbol.
+     * @param qualified The qualified name of the symbol.
+     * @param kind The kind of the symbol, like "class" or "method".
+     * @param usr The USR of the symbol.
+     * @param brief The brief description in XML.
+     */
+    void add(const std::string& name, const std::string& qualified,
+            const std::string& kind, const std::string& usr,
+            const std::string& brief);
+
+    /**
+     * @brief Add all symbols of another index.
+     *
+     * @details
+     * The symbols of @p other are added as if they were added to this index
+     * directly, in the same order.
+     *
+     * @param other The index to add the symbols of.
+     */
+    void add(const SearchIndex& other);
+
+    /**
+     * @brief Write the index in JSON.
+     *
+     * @param ostr The stream to output the index to.
+     */
+    void write(std::ostream& ostr) const;
+
+private:
+    /* An indexed symbol */
+    struct Symbol
+    {
+        /* The name of the symbol */
+        std::string name;
+
+        /* The qualified name of the symbol */
+        std::string qualified;
+
+        /* The kind of the symbol */
+        std::string kind;
+
+        /* The USR of the symbol */
+        std::string usr;
+
+        /* The lower-case name of the symbol, to sort by */
+        std::string key;
+    };
+
+    /* Split the text of an XML fragment in lower-case words */
+    static std::vector<std::string> tokenize(const std::string& xml);
+
+    /* The symbols in the order they were added */
+    std::vector<Symbol> _symbols;
+
+    /* The index in _symbols of each symbol by its USR */
+    std::unordered_map<std::string, size_t> _index;
+
+    /* The symbols that contain each token, by their index in _symbols */
+    std::map<std::string, std::vector<size_t>> _tokens;
+};
+
+} // namespace muddoc
+
+#endif /* _MUDDOC_SEARCH_H_ */
@@ -0,0 +1,544 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#include "descriptor.h"
+#include "fingerprint.h"
+#include "sink.h"
+#include "symbols.h"
+#include "utility.h"
+#include "warn_error.h"
+
+namespace muddoc {
+
+/* ==== Sinks ==== */
+
+void
+Sinks::begin(const std::string& file, const SymbolIndex& symbols)
+{
+    for (auto sink: _sinks) {
+        sink->begin(file, symbols);
+    }
+}
+
+void
+Sinks::end(const std::string& file, uint64_t hash)
+{
+    for (auto sink: _sinks) {
+        sink->end(file, hash);
+    }
+}
+
+void
+Sinks::begin(const NamespaceDescriptor& descriptor)
+{
+    for (auto sink: _sinks) {
+        sink->begin(descriptor);
+    }
+}
+
+void
+Sinks::end(const NamespaceDescriptor& descriptor)
+{
+    for (auto sink: _sinks) {
+        sink->end(descriptor);
+    }
+}
+
+void
+Sinks::begin(const ClassDescriptor& descriptor)
+{
+    for (auto sink: _sinks) {
+        sink->begin(descriptor);
+    }
+}
+
+void
+Sinks::end(const ClassDescriptor& descriptor)
+{
+    for (auto sink: _sinks) {
+        sink->end(descriptor);
+    }
+}
+
+void
+Sinks::begin(const EnumDescriptor& descriptor)
+{
+    for (auto sink: _sinks) {
+        sink->begin(descriptor);
+    }
+}
+
+void
+Sinks::end(const EnumDescriptor& descriptor)
+{
+    for (auto sink: _sinks) {
+        sink->end(descriptor);
+    }
+}
+
+void
+Sinks::method(const ConstructorDescriptor& descriptor)
+{
+    for (auto sink: _sinks) {
+        sink->method(descriptor);
+    }
+}
+
+void
+Sinks::method(const DestructorDescriptor& descriptor)
+{
+    for (auto sink: _sinks) {
+        sink->method(descriptor);
+    }
+}
+
+void
+Sinks::method(const MethodDescriptor& descriptor)
+{
+    for (auto sink: _sinks) {
+        sink->method(descriptor);
+    }
+}
+
+void
+Sinks::value(const EnumConstantDescriptor& descriptor)
+{
+    for (auto sink: _sinks) {
+        sink->value(descriptor);
+    }
+}
+
+void
+Sinks::param(const ParamDescriptor& descriptor)
+{
+    for (auto sink: _sinks) {
+        sink->param(descriptor);
+    }
+}
+
+void
+Sinks::returns(const std::string& text)
+{
+    for (auto sink: _sinks) {
+        sink->returns(text);
+    }
+}
+
+void
+Sinks::brief(const std::string& text)
+{
+    for (auto sink: _sinks) {
+        sink->brief(text);
+    }
+}
+
+void
+Sinks::detailed(const std::string& text)
+{
+    for (auto sink: _sinks) {
+        sink->detailed(text);
+    }
+}
+
+uint64_t
+Sinks::size() const
+{
+    uint64_t size = 0;
+    for (auto sink: _sinks) {
+        size += sink->size();
+    }
+    return size;
+}
+
+/* ==== OverloadSets ==== */
+
+std::ostream&
+OverloadSets::add(const std::string& name, const char* kind)
+{
+    auto iter = _index.find(name);
+    if (iter != _index.end()) {
+        return _sets[iter->second].members;
+    }
+    _index.emplace(name, _sets.size());
+    _sets.emplace_back();
+    Set& set = _sets.back();
+    set.name = name;
+    set.kind = kind;
+    return set.members;
+}
+
+/* ==== XmlSink ==== */
+
+/* Serialise the fingerprint of a description as its last element, if any */
+static std::string
+hashed(uint64_t hash)
+{
+    return hash != 0 ? "<hash>" + Fingerprint::hex(hash) + "</hash>" : "";
+}
+
+/* Output the properties of a method, with the attribute of its kind if it is
+ * a constructor or destructor */
+static void
+info(std::ostream& ostr, const clang::CXXMethodDecl* decl, const char* kind)
+{
+    ostr << "<info";
+    if (kind != nullptr)
+        ostr << " " << kind << "=\"true\"";
+    if (decl->isCopyAssignmentOperator())
+        ostr << " copy-assignment=\"true\"";
+    if (decl->isMoveAssignmentOperator())
+        ostr << " move-assignment=\"true\"";
+    if (decl->isOverloadedOperator())
+        ostr << " overloaded-operator=\"true\"";
+    if (decl->isStatic())
+        ostr << " static=\"true\"";
+    if (decl->isConst())
+        ostr << " const=\"true\"";
+    if (decl->isConstexpr())
+        ostr << " const-expr=\"true\"";
+    if (decl->isConsteval())
+        ostr << " const-eval=\"true\"";
+    if (decl->isVirtual())
+        ostr << " virtual=\"true\"";
+    if (decl->isPureVirtual())
+        ostr << " pure-virtual=\"true\"";
+    if (decl->isDefaulted())
+        ostr << " default=\"true\"";
+    if (decl->isDeleted())
+        ostr << " delete=\"true\"";
+    if (decl->isVariadic())
+        ostr << " variadic=\"true\"";
+    if (decl->isGlobal())
+        ostr << " global=\"true\"";
+    if (decl->isExternC())
+        ostr << " extern-c=\"true\"";
+    if (decl->isInlined())
+        ostr << " inline=\"true\"";
+    switch (decl->getAccess()) {
+        case clang::AccessSpecifier::AS_private:
+            ostr << " access=\"private\"";
+            break;
+        case clang::AccessSpecifier::AS_protected:
+            ostr << " access=\"protected\"";
+            break;
+        default:
+            ostr << " access=\"public\"";
+            break;
+    }
+    ostr << "/>";
+}
+
+/* Count the bytes that are output to a stream during its lifetime, except
+ * for the methods that have been counted when they were buffered, or nothing
+ * if the position of the stream is not known */
+class Counter
+{
+public:
+    Counter(std::ostream& ostr, uint64_t& size)
+        : _ostr(ostr), _size(size), _start(ostr.tellp()), _copied(0)
+    {
+    }
+
+    ~Counter()
+    {
+        std::streampos end = _ostr.tellp();
+        if (_start != std::streampos(-1) && end != std::streampos(-1)) {
+            _size += static_cast<uint64_t>(end - _start) - _copied;
+        }
+    }
+
+    void copied(uint64_t bytes) { _copied += bytes; }
+
+private:
+    std::ostream& _ostr;
+    uint64_t& _size;
+    std::streampos _start;
+    uint64_t _copied;
+};
+
+XmlSink::XmlSink(std::ostream& ostr, bool strict)
+    : _ostr(ostr), _strict(strict), _symbols(nullptr), _current(&ostr),
+      _parameters(false), _size(0)
+{
+}
+
+void
+XmlSink::begin(const std::string& file, const SymbolIndex& symbols)
+{
+    _symbols = &symbols;
+    _unresolved.clear();
+    _reported.clear();
+    _frames.clear();
+    _frames.emplace_back();
+    _current = &_ostr;
+    _parameters = false;
+    _after.clear();
+    Counter counter(_ostr, _size);
+    _ostr << "<doc file=\"" << escape(file) << "\">";
+}
+
+void
+XmlSink::end(const std::string& file, uint64_t hash)
+{
+    Counter counter(_ostr, _size);
+    _ostr << hashed(hash) << "</doc>";
+    _frames.clear();
+    _symbols = nullptr;
+    if (_strict && !_unresolved.empty()) {
+        warn("unresolved-ref", SymbolIndex::summary(_unresolved));
+    }
+}
+
+void
+XmlSink::begin(const NamespaceDescriptor& descriptor)
+{
+    _frames.emplace_back();
+    Counter counter(_ostr, _size);
+    _ostr << "<namespace"
+          << " name=\"" << escape(descriptor.name()) << "\""
+          << " qualified=\"" << escape(descriptor.qualified()) << "\""
+          << ">";
+    _ostr << "<usr>" << escape(descriptor.usr()) << "</usr>";
+    declared(_ostr, std::string());
+}
+
+void
+XmlSink::end(const NamespaceDescriptor& descriptor)
+{
+    _frames.pop_back();
+    Counter counter(_ostr, _size);
+    _ostr << hashed(descriptor.hash()) << "</namespace>";
+}
+
+void
+XmlSink::begin(const ClassDescriptor& descriptor)
+{
+    _frames.emplace_back();
+    _frames.back().grouped = true;
+    Counter counter(_ostr, _size);
+    _ostr << "<class"
+          << " name=\"" << escape(descriptor.name()) << "\""
+          << " qualified=\"" << escape(descriptor.qualified()) << "\""
+          << " namespace=\"" << escape(descriptor.enclosing()) << "\""
+          << " path=\"" << escape(descriptor.path()) << "\""
+          << ">";
+    _ostr << "<usr>" << escape(descriptor.usr()) << "</usr>";
+    _ostr << "<declaration>" << escape(descriptor.declaration())
+          << "</declaration>";
+    declared(_ostr, std::string());
+}
+
+void
+XmlSink::end(const ClassDescriptor& descriptor)
+{
+    // The other members have been output already, the methods follow them
+    // grouped by name.
+    Frame& frame = _frames.back();
+    Counter counter(_ostr, _size);
+    for (const auto& set: frame.overloads._sets) {
+        _ostr << "<overload-set"
+              << " name=\"" << escape(set.name) << "\""
+              << " kind=\"" << set.kind << "\""
+              << " namespace=\""
+              << escape(descriptor.enclosing() + descriptor.name()) << "::\""
+              << " path=\"" << escape(descriptor.path() + set.name) << "\""
+              << ">";
+        std::string methods = set.members.str();
+        _ostr << methods;
+        counter.copied(methods.size());
+        _ostr << "</overload-set>";
+    }
+    _ostr << hashed(descriptor.hash()) << "</class>";
+    _frames.pop_back();
+}
+
+void
+XmlSink::begin(const EnumDescriptor& descriptor)
+{
+    _frames.emplace_back();
+    Counter counter(_ostr, _size);
+    _ostr << "<enum"
+          << " name=\"" << escape(descriptor.name()) << "\""
+          << ">";
+    _ostr << "<usr>" << escape(descriptor.usr()) << "</usr>";
+    declared(_ostr, "<values>");
+}
+
+void
+XmlSink::end(const EnumDescriptor& descriptor)
+{
+    _frames.pop_back();
+    Counter counter(_ostr, _size);
+    _ostr << "</values>" << hashed(descriptor.hash()) << "</enum>";
+}
+
+/* Output the start of a constructor, destructor or method, its comments
+ * follow as text events */
+template <typename T>
+void
+XmlSink::method(const T& descriptor, const char* kind, const char* set)
+{
+    std::ostream& ostr = output(descriptor.name(), set);
+    Counter counter(ostr, _size);
+    ostr << "<method"
+         << " name=\"" << escape(descriptor.name()) << "\""
+         << " namespace=\"" << escape(descriptor.enclosing()) << "\""
+         << " path=\"" << escape(descriptor.path()) << "\""
+         << ">";
+    info(ostr, descriptor.decl(), kind);
+    ostr << "<usr>" << escape(descriptor.usr()) << "</usr>";
+    ostr << "<declaration>" << escape(descriptor.declaration())
+         << "</declaration>";
+    declared(ostr, hashed(descriptor.hash()) + "</method>");
+}
+
+void
+XmlSink::method(const ConstructorDescriptor& descriptor)
+{
+    method(descriptor, "constructor", "constructor");
+}
+
+void
+XmlSink::method(const DestructorDescriptor& descriptor)
+{
+    method(descriptor, "destructor", "destructor");
+}
+
+void
+XmlSink::method(const MethodDescriptor& descriptor)
+{
+    method(descriptor, nullptr, "method");
+}
+
+void
+XmlSink::value(const EnumConstantDescriptor& descriptor)
+{
+    Counter counter(_ostr, _size);
+    _ostr << "<value"
+          << " name=\"" << escape(descriptor.name()) << "\""
+          << ">";
+    _ostr << "<usr>" << escape(descriptor.usr()) << "</usr>";
+    declared(_ostr, hashed(descriptor.hash()) + "</value>");
+}
+
+void
+XmlSink::param(const ParamDescriptor& descriptor)
+{
+    std::ostream& ostr = *_current;
+    Counter counter(ostr, _size);
+    if (!_parameters) {
+        ostr << "<parameters>";
+        _parameters = true;
+    }
+    ostr << "<param index=\"" << descriptor.index() << "\">";
+    ostr << "<name>" << escape(descriptor.name()) << "</name>";
+    text(ostr, "brief", descriptor.description());
+    ostr << "</param>";
+}
+
+void
+XmlSink::returns(const std::string& xml)
+{
+    std::ostream& ostr = *_current;
+    Counter counter(ostr, _size);
+    parameters(ostr);
+    text(ostr, "return", xml);
+}
+
+void
+XmlSink::brief(const std::string& xml)
+{
+    std::ostream& ostr = *_current;
+    Counter counter(ostr, _size);
+    parameters(ostr);
+    text(ostr, "brief", xml);
+}
+
+void
+XmlSink::detailed(const std::string& xml)
+{
+    // The detailed text is the last text event of a declaration, so the
+    // element of a method or constant ends with it.
+    std::ostream& ostr = *_current;
+    Counter counter(ostr, _size);
+    parameters(ostr);
+    text(ostr, "detailed", xml);
+    ostr << _after;
+    _after.clear();
+    _current = &_ostr;
+}
+
+void
+XmlSink::declared(std::ostream& ostr, const std::string& after)
+{
+    _current = &ostr;
+    _parameters = false;
+    _after = after;
+}
+
+void
+XmlSink::parameters(std::ostream& ostr)
+{
+    if (_parameters) {
+        ostr << "</parameters>";
+        _parameters = false;
+    }
+}
+
+void
+XmlSink::text(std::ostream& ostr, const char* name, const std::string& xml)
+{
+    // Resolve the cross-references in the text against the index of all
+    // the symbols, only the names that cannot be found are collected.
+    ostr << "<" << name << ">";
+    if (xml.find("<ref ") == std::string::npos) {
+        ostr << xml;
+    }
+    else {
+        std::vector<std::string> unresolved;
+        _symbols->resolve(xml, ostr, unresolved);
+        for (auto& ref: unresolved) {
+            if (_reported.insert(ref).second) {
+                _unresolved.push_back(std::move(ref));
+            }
+        }
+    }
+    ostr << "</" << name << ">";
+}
+
+std::ostream&
+XmlSink::output(const std::string& name, const char* kind)
+{
+    // The methods of a class are added to the overload set of their name,
+    // otherwise they are output in sequence with the other members.
+    Frame& frame = _frames.back();
+    if (!frame.grouped) {
+        return _ostr;
+    }
+    return frame.overloads.add(name, kind);
+}
+
+} // namespace muddoc
@@ -0,0 +1,555 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#ifndef _MUDDOC_SINK_H_
+#define _MUDDOC_SINK_H_
+
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace muddoc {
+
+/** Forward declaration */
+class NamespaceDescriptor;
+class ClassDescriptor;
+class ConstructorDescriptor;
+class DestructorDescriptor;
+class MethodDescriptor;
+class EnumDescriptor;
+class EnumConstantDescriptor;
+class ParamDescriptor;
+class SymbolIndex;
+
+/**
+ * @brief Receiver of the events of a documented translation unit.
+ *
+ * @details
+ * The @c Visitor emits an event for every declaration it documents, in the
+ * order of the declarations, while it walks the translation unit. A scope,
+ * like a namespace, is reported by a @c begin event before its members and
+ * an @c end event after them, such that a sink can output the documentation
+ * as it is generated instead of building it up first:
+ *
+ * @code
+ * begin("file.h", symbols)
+ *   begin(namespace)
+ *     brief(text) detailed(text)
+ *     begin(class)
+ *       param(parameter) brief(text) detailed(text)
+ *       method(constructor)
+ *         param(parameter) brief(text) detailed(text)
+ *       method(method)
+ *         param(parameter) returns(text) brief(text) detailed(text)
+ *     end(class)
+ *     begin(enum)
+ *       brief(text) detailed(text)
+ *       value(constant)
+ *         brief(text) detailed(text)
+ *     end(enum)
+ *   end(namespace)
+ * end("file.h", hash)
+ * @endcode
+ *
+ * The descriptor of a declaration event holds its name, its USR, its
+ * signature and its hash, and is only valid for the duration of the event.
+ * At the @c begin of a scope its description is complete, except for its
+ * hash which also covers its members and is only known at its @c end.
+ *
+ * The comments of a declaration follow its event as text events, before
+ * the event of any other declaration: a @c param event for each described
+ * parameter, a @c returns event for the description of the return value of
+ * a method, and always a @c brief and a @c detailed event, which ends them.
+ * The text is rendered with inline markup, like the elements of the XML,
+ * and its cross-references are unresolved. All the symbols that are
+ * documented are indexed before the first event, such that the references
+ * can be resolved as they arrive.
+ *
+ * Each output format is a sink. By default an event is ignored, so a sink
+ * only overrides the events it needs.
+ */
+class Sink
+{
+public:
+    /**
+     * @brief Destructor.
+     */
+    virtual ~Sink() = default;
+
+    /**
+     * @brief The documentation of a file starts.
+     *
+     * @param file The name of the documented file.
+     * @param symbols The symbols that are documented, to resolve the
+     * cross-references in the comments. It remains valid until the end of
+     * the file.
+     */
+    virtual void begin(const std::string& /* file */,
+            const SymbolIndex& /* symbols */) {}
+
+    /**
+     * @brief The documentation of a file ends.
+     *
+     * @param file The name of the documented file.
+     * @param hash The hash of the top-level declarations, or 0 if the
+     * fingerprints are not computed.
+     */
+    virtual void end(const std::string& /* file */, uint64_t /* hash */) {}
+
+    /**
+     * @brief A namespace starts, before its members.
+     *
+     * @param descriptor The description of the namespace.
+     */
+    virtual void begin(const NamespaceDescriptor& /* descriptor */) {}
+
+    /**
+     * @brief A namespace ends, after its members.
+     *
+     * @param descriptor The description of the namespace.
+     */
+    virtual void end(const NamespaceDescriptor& /* descriptor */) {}
+
+    /**
+     * @brief A class, struct or union starts, before its members.
+     *
+     * @param descriptor The description of the class.
+     */
+    virtual void begin(const ClassDescriptor& /* descriptor */) {}
+
+    /**
+     * @brief A class, struct or union ends, after its members.
+     *
+     * @param descriptor The description of the class.
+     */
+    virtual void end(const ClassDescriptor& /* descriptor */) {}
+
+    /**
+     * @brief An enumeration starts, before its constants.
+     *
+     * @param descriptor The description of the enumeration.
+     */
+    virtual void begin(const EnumDescriptor& /* descriptor */) {}
+
+    /**
+     * @brief An enumeration ends, after its constants.
+     *
+     * @param descriptor The description of the enumeration.
+     */
+    virtual void end(const EnumDescriptor& /* descriptor */) {}
+
+    /**
+     * @brief A constructor of the current class.
+     *
+     * @param descriptor The description of the constructor.
+     */
+    virtual void method(const ConstructorDescriptor& /* descriptor */) {}
+
+    /**
+     * @brief A destructor of the current class.
+     *
+     * @param descriptor The description of the destructor.
+     */
+    virtual void method(const DestructorDescriptor& /* descriptor */) {}
+
+    /**
+     * @brief A method of the current class.
+     *
+     * @param descriptor The description of the method.
+     */
+    virtual void method(const MethodDescriptor& /* descriptor */) {}
+
+    /**
+     * @brief A constant of the current enumeration.
+     *
+     * @param descriptor The description of the constant.
+     */
+    virtual void value(const EnumConstantDescriptor& /* descriptor */) {}
+
+    /**
+     * @brief A described parameter of the current declaration.
+     *
+     * @param descriptor The description of the parameter.
+     */
+    virtual void param(const ParamDescriptor& /* descriptor */) {}
+
+    /**
+     * @brief The description of the return value of the current method.
+     *
+     * @param text The rendered text.
+     */
+    virtual void returns(const std::string& /* text */) {}
+
+    /**
+     * @brief The brief description of the current declaration.
+     *
+     * @param text The rendered text, which may be empty.
+     */
+    virtual void brief(const std::string& /* text */) {}
+
+    /**
+     * @brief The detailed description of the current declaration, its last
+     * text event.
+     *
+     * @param text The rendered text, which may be empty.
+     */
+    virtual void detailed(const std::string& /* text */) {}
+
+    /**
+     * @brief Get the number of bytes that have been output.
+     *
+     * @details
+     * The number only has to grow as output is produced, it is used to
+     * profile the size of the output per symbol.
+     *
+     * @return The number of bytes output so far, 0 if it is not counted.
+     */
+    virtual uint64_t size() const { return 0; }
+
+protected:
+    Sink() = default;
+};
+
+/**
+ * @brief Sink that passes the events on to a set of sinks.
+ *
+ * @details
+ * Every event is passed to all the sinks, in the order they were added,
+ * such that a single walk of a translation unit feeds every output format.
+ * Without any sinks, the events are ignored.
+ */
+class Sinks: public Sink
+{
+public:
+    /**
+     * @brief Create an empty set of sinks.
+     */
+    Sinks() = default;
+
+    /**
+     * @brief Add a sink.
+     *
+     * @param sink The sink to pass the events to, it has to outlive this
+     * object.
+     */
+    void add(Sink& sink) { _sinks.push_back(&sink); }
+
+    /**
+     * @brief Check if there are any sinks.
+     *
+     * @return True if no sink has been added.
+     */
+    bool empty() const { return _sinks.empty(); }
+
+    /**
+     * @brief Pass the event on to all sinks, see @c Sink.
+     */
+    void begin(const std::string& file,
+            const SymbolIndex& symbols) override;
+    void end(const std::string& file, uint64_t hash) override;
+    void begin(const NamespaceDescriptor& descriptor) override;
+    void end(const NamespaceDescriptor& descriptor) override;
+    void begin(const ClassDescriptor& descriptor) override;
+    void end(const ClassDescriptor& descriptor) override;
+    void begin(const EnumDescriptor& descriptor) override;
+    void end(const EnumDescriptor& descriptor) override;
+    void method(const ConstructorDescriptor& descriptor) override;
+    void method(const DestructorDescriptor& descriptor) override;
+    void method(const MethodDescriptor& descriptor) override;
+    void value(const EnumConstantDescriptor& descriptor) override;
+    void param(const ParamDescriptor& descriptor) override;
+    void returns(const std::string& text) override;
+    void brief(const std::string& text) override;
+    void detailed(const std::string& text) override;
+
+    /**
+     * @brief Get the number of bytes that have been output.
+     *
+     * @return The total of the bytes output by all sinks.
+     */
+    uint64_t size() const override;
+
+private:
+    /* The sinks to pass the events to */
+    std::vector<Sink*> _sinks;
+};
+
+/**
+ * @brief Methods of a class grouped by name.
+ *
+ * @details
+ * All the methods of a class that share the same name form an overload set.
+ * The overload sets are gathered while the members of a class are visited,
+ * such that any consumer of the output does not need to group the methods
+ * itself. The sets are kept in the order in which the first method of each
+ * set was encountered.
+ */
+class OverloadSets
+{
+public:
+    /**
+     * @brief Create an empty collection of overload sets.
+     */
+    OverloadSets() = default;
+
+    /**
+     * @brief Return the stream to output a method to.
+     *
+     * @details
+     * Look up the overload set for the method @p name, creating a new set if
+     * this is the first method with that name.
+     *
+     * @param name The name of the method.
+     * @param kind The kind of method (constructor, destructor or method).
+     * @return The stream to output the method description to.
+     */
+    std::ostream& add(const std::string& name, const char* kind);
+
+    /**
+     * @brief Check if there are any overload sets.
+     * @return True if no method has been added.
+     */
+    bool empty() const { return _sets.empty(); }
+
+private:
+    /* Friend class */
+    friend class XmlSink;
+
+    /* A single overload set */
+    struct Set
+    {
+        /* The name of the methods */
+        std::string name;
+
+        /* The kind of the methods */
+        const char* kind;
+
+        /* The XML representation of the methods */
+        std::ostringstream members;
+    };
+
+    /* The index of each set by name */
+    std::unordered_map<std::string, size_t> _index;
+
+    /* The overload sets in order of appearance */
+    std::deque<Set> _sets;
+};
+
+/**
+ * @brief Sink that outputs the documentation in XML.
+ *
+ * @details
+ * The documentation of a file is output as a @c doc element, that contains
+ * an element for each declaration:
+ *
+ * @code
+ * <doc file="FILE">
+ *   <namespace name="NAME" qualified="QUALIFIED">
+ *     <usr>USR</usr>
+ *     <brief/>
+ *     <detailed/>
+ *     MEMBERS
+ *     <hash>HASH</hash>
+ *   </namespace>
+ *   <hash>HASH</hash>
+ * </doc>
+ * @endcode
+ *
+ * A class has the same content as a namespace, preceded by its declaration
+ * and template parameters, and has the additional attributes for its
+ * enclosing scope and its output path:
+ *
+ * @code
+ * <class name="NAME" qualified="QUALIFIED" namespace="NS::" path="NS/NAME/">
+ *   <usr>USR</usr>
+ *   <declaration>DECLARATION</declaration>
+ *   <parameters>
+ *     <param index="INDEX"><name>NAME</name><brief>BRIEF</brief></param>
+ *   </parameters>
+ *   <brief/>
+ *   <detailed/>
+ *   MEMBERS
+ *   <overload-set name="METHOD" kind="KIND" namespace="NS::NAME::"
+ *                 path="NS/NAME/METHOD">
+ *     METHODS
+ *   </overload-set>
+ *   <hash>HASH</hash>
+ * </class>
+ * @endcode
+ *
+ * The methods are not part of the @c MEMBERS but are grouped by name in
+ * overload sets, which follow the other members. The @c KIND of a set is
+ * either "constructor", "destructor" or "method". A method has the
+ * properties of its declaration, like @c static or @c virtual, as the
+ * attributes of its @c info element, which also has a @c constructor or
+ * @c destructor attribute for those kinds:
+ *
+ * @code
+ * <method name="NAME" namespace="NS::CLASS::" path="NS/CLASS/NAME">
+ *   <info access="ACCESS" KEY="true"/>
+ *   <usr>USR</usr>
+ *   <declaration>DECLARATION</declaration>
+ *   <parameters>
+ *     <param index="INDEX"><name>NAME</name><brief>BRIEF</brief></param>
+ *   </parameters>
+ *   <return>RETURN</return>
+ *   <brief/>
+ *   <detailed/>
+ *   <hash>HASH</hash>
+ * </method>
+ * @endcode
+ *
+ * An enumeration has the same content as a namespace, with its constants
+ * in a @c values element:
+ *
+ * @code
+ * <enum name="NAME">
+ *   <usr>USR</usr>
+ *   <brief/>
+ *   <detailed/>
+ *   <values>
+ *     <value name="NAME"><usr/><brief/><detailed/><hash/></value>
+ *   </values>
+ *   <hash>HASH</hash>
+ * </enum>
+ * @endcode
+ *
+ * The cross-references in the comments are resolved as they are output,
+ * against the index of all the symbols of the file. The elements are output
+ * as their events arrive, with the comments from the text events, and the
+ * hash of a scope, that is only known once all its members have been seen,
+ * as its last child. The @c hash
+ * elements are only output with fingerprints. Only the overload sets of a
+ * class are held back, until the end of the class.
+ */
+class XmlSink: public Sink
+{
+public:
+    /**
+     * @brief Create a sink that outputs XML.
+     *
+     * @param ostr The stream to output the documentation to.
+     * @param strict True to warn about the references that cannot be
+     * resolved, false if only part of the file is documented.
+     */
+    XmlSink(std::ostream& ostr, bool strict = true);
+
+    /**
+     * @brief Output the event in XML, see @c Sink.
+     */
+    void begin(const std::string& file,
+            const SymbolIndex& symbols) override;
+    void end(const std::string& file, uint64_t hash) override;
+    void begin(const NamespaceDescriptor& descriptor) override;
+    void end(const NamespaceDescriptor& descriptor) override;
+    void begin(const ClassDescriptor& descriptor) override;
+    void end(const ClassDescriptor& descriptor) override;
+    void begin(const EnumDescriptor& descriptor) override;
+    void end(const EnumDescriptor& descriptor) override;
+    void method(const ConstructorDescriptor& descriptor) override;
+    void method(const DestructorDescriptor& descriptor) override;
+    void method(const MethodDescriptor& descriptor) override;
+    void value(const EnumConstantDescriptor& descriptor) override;
+    void param(const ParamDescriptor& descriptor) override;
+    void returns(const std::string& text) override;
+    void brief(const std::string& text) override;
+    void detailed(const std::string& text) override;
+
+    /**
+     * @brief Get the number of bytes that have been output.
+     *
+     * @return The number of bytes output so far, where the methods are
+     * counted once when they are added to their overload set, not again
+     * when the set is output. It is 0 if the stream has no position.
+     */
+    uint64_t size() const override { return _size; }
+
+private:
+    /* A scope that is being output */
+    struct Frame
+    {
+        /* The methods grouped by name, output at the end of the scope */
+        OverloadSets overloads;
+
+        /* True if the methods are grouped, only within a class */
+        bool grouped = false;
+    };
+
+    /* Output the start of a constructor, destructor or method */
+    template <typename T>
+    void method(const T& descriptor, const char* kind, const char* set);
+
+    /* Start the text events of a declaration, output to a stream */
+    void declared(std::ostream& ostr, const std::string& after);
+
+    /* Output the end of the described parameters, if any */
+    void parameters(std::ostream& ostr);
+
+    /* Output the element of a text, with its cross-references resolved */
+    void text(std::ostream& ostr, const char* name, const std::string& xml);
+
+    /* Return the stream to output a method to */
+    std::ostream& output(const std::string& name, const char* kind);
+
+    /* The stream to output to */
+    std::ostream& _ostr;
+
+    /* True to warn about unresolved references */
+    bool _strict;
+
+    /* The symbols to resolve the references against, during a file */
+    const SymbolIndex* _symbols;
+
+    /* The names of the unresolved references, in order of appearance */
+    std::vector<std::string> _unresolved;
+
+    /* The names of the unresolved references, to report each once */
+    std::unordered_set<std::string> _reported;
+
+    /* The frames of the file and the scopes that are being output */
+    std::deque<Frame> _frames;
+
+    /* The stream of the declaration that the text events belong to */
+    std::ostream* _current;
+
+    /* True if the parameters element of the declaration is open */
+    bool _parameters;
+
+    /* The markup to output after the detailed text of the declaration */
+    std::string _after;
+
+    /* The number of bytes output so far */
+    uint64_t _size;
+};
+
+} // namespace muddoc
+
+#endif /* _MUDDOC_SINK_H_ */
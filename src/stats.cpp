@@ -0,0 +1,301 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sys/resource.h>
+#include <time.h>
+#include "stats.h"
+#include "utility.h"
+
+namespace muddoc {
+
+/* The names of the phases, in the order of Stats::Phase */
+static const char* phases[] = {
+    "other", "parse", "comments", "render", "pretty", "usr", "escape",
+    "serialize", "write"
+};
+
+/* The names of the counters, in the order of Stats::Counter */
+static const char* counters[] = {
+    "cursors-visited", "cursors-filtered", "namespaces", "classes",
+    "constructors", "destructors", "methods", "enums", "enum-constants",
+    "comments-parsed", "comments-scanned", "bytes-escaped", "bytes-written"
+};
+
+/* The names of the descriptor kinds, in the order of Stats::Kind */
+static const char* kinds[] = {
+    "unowned", "namespace", "class", "constructor", "destructor", "method",
+    "enum", "enum-constant"
+};
+
+bool Stats::_enabled = false;
+bool Stats::_memory = false;
+bool Stats::_allocations = false;
+
+/* The statistics of the current thread, if not its own */
+static thread_local Stats* current = nullptr;
+
+Stats::Stats()
+    : _wall(), _cpu(), _counters(), _allocations_by_phase(),
+      _bytes_by_phase(), _allocations_by_kind(), _bytes_by_kind(),
+      _kind(Unowned), _depth(0), _phase(Other), _wall_start(0), _cpu_start(0)
+{
+}
+
+Stats&
+Stats::local()
+{
+    static thread_local Stats own;
+    return current != nullptr ? *current : own;
+}
+
+void
+Stats::local(Stats* stats)
+{
+    current = stats;
+}
+
+void
+Stats::add(const Stats& other)
+{
+    for (int i = 0; i < Phases; ++i) {
+        _wall[i] += other._wall[i];
+        _cpu[i] += other._cpu[i];
+    }
+    for (int i = 0; i < Counters; ++i) {
+        _counters[i] += other._counters[i];
+    }
+    for (int i = 0; i < Phases; ++i) {
+        _allocations_by_phase[i] += other._allocations_by_phase[i];
+        _bytes_by_phase[i] += other._bytes_by_phase[i];
+    }
+    for (int i = 0; i < Kinds; ++i) {
+        _allocations_by_kind[i] += other._allocations_by_kind[i];
+        _bytes_by_kind[i] += other._bytes_by_kind[i];
+    }
+    for (const auto& resource: other._unit) {
+        uint64_t& amount = _unit[resource.first];
+        amount = std::max(amount, resource.second);
+    }
+}
+
+void
+Stats::usage(CXTranslationUnit unit)
+{
+    if (!_memory) {
+        return;
+    }
+    Stats& stats = local();
+    CXTUResourceUsage usage = clang_getCXTUResourceUsage(unit);
+    uint64_t total = 0;
+    for (unsigned i = 0; i < usage.numEntries; ++i) {
+        const CXTUResourceUsageEntry& entry = usage.entries[i];
+        uint64_t& amount =
+            stats._unit[clang_getTUResourceUsageName(entry.kind)];
+        amount = std::max<uint64_t>(amount, entry.amount);
+        total += entry.amount;
+    }
+    uint64_t& amount = stats._unit["total"];
+    amount = std::max(amount, total);
+    clang_disposeCXTUResourceUsage(usage);
+}
+
+void
+Stats::snapshot(uint64_t (&wall)[Phases])
+{
+    charge();
+    for (int i = 0; i < Phases; ++i) {
+        wall[i] = _wall[i];
+    }
+}
+
+void
+Stats::text(std::ostream& ostr, double elapsed) const
+{
+    ostr << std::fixed << std::setprecision(3)
+         << "muddoc statistics (elapsed " << elapsed << " s)\n"
+         << "  " << std::left << std::setw(18) << "phase"
+         << std::right << std::setw(12) << "wall (s)"
+         << std::setw(12) << "cpu (s)" << "\n";
+    for (int i = 0; i < Phases; ++i) {
+        ostr << "  " << std::left << std::setw(18) << phases[i]
+             << std::right << std::setw(12) << _wall[i] / 1e9
+             << std::setw(12) << _cpu[i] / 1e9 << "\n";
+    }
+    ostr << "  " << std::left << std::setw(18) << "counter"
+         << std::right << std::setw(12) << "value" << "\n";
+    for (int i = 0; i < Counters; ++i) {
+        ostr << "  " << std::left << std::setw(18) << counters[i]
+             << std::right << std::setw(12) << _counters[i] << "\n";
+    }
+    if (_memory) {
+        text_memory(ostr);
+    }
+    ostr << std::defaultfloat;
+}
+
+void
+Stats::text_memory(std::ostream& ostr) const
+{
+    ostr << "  " << std::left << std::setw(42) << "peak resident set (bytes)"
+         << std::right << std::setw(12) << peak() << "\n";
+    ostr << "  " << std::left << std::setw(42)
+         << "translation unit resource" << std::right << std::setw(12)
+         << "bytes" << "\n";
+    for (const auto& resource: _unit) {
+        ostr << "  " << std::left << std::setw(42) << resource.first
+             << std::right << std::setw(12) << resource.second << "\n";
+    }
+    if (!_allocations) {
+        return;
+    }
+    ostr << "  " << std::left << std::setw(18) << "phase"
+         << std::right << std::setw(12) << "allocations"
+         << std::setw(12) << "bytes" << "\n";
+    for (int i = 0; i < Phases; ++i) {
+        ostr << "  " << std::left << std::setw(18) << phases[i]
+             << std::right << std::setw(12) << _allocations_by_phase[i]
+             << std::setw(12) << _bytes_by_phase[i] << "\n";
+    }
+    ostr << "  " << std::left << std::setw(18) << "descriptor"
+         << std::right << std::setw(12) << "allocations"
+         << std::setw(12) << "bytes" << "\n";
+    for (int i = 0; i < Kinds; ++i) {
+        ostr << "  " << std::left << std::setw(18) << kinds[i]
+             << std::right << std::setw(12) << _allocations_by_kind[i]
+             << std::setw(12) << _bytes_by_kind[i] << "\n";
+    }
+}
+
+void
+Stats::json(std::ostream& ostr, double elapsed) const
+{
+    ostr << std::setprecision(9)
+         << "{\"elapsed\":" << elapsed << ",\"phases\":{";
+    for (int i = 0; i < Phases; ++i) {
+        ostr << (i > 0 ? "," : "") << "\"" << phases[i] << "\":"
+             << "{\"wall\":" << _wall[i] / 1e9
+             << ",\"cpu\":" << _cpu[i] / 1e9 << "}";
+    }
+    ostr << "},\"counters\":{";
+    for (int i = 0; i < Counters; ++i) {
+        ostr << (i > 0 ? "," : "") << "\"" << counters[i] << "\":"
+             << _counters[i];
+    }
+    ostr << "}";
+    if (_memory) {
+        json_memory(ostr);
+    }
+    ostr << "}" << std::endl;
+}
+
+void
+Stats::json_memory(std::ostream& ostr) const
+{
+    ostr << ",\"memory\":{\"peak-rss\":" << peak() << ",\"unit\":{";
+    bool first = true;
+    for (const auto& resource: _unit) {
+        ostr << (first ? "" : ",") << quote(resource.first) << ":"
+             << resource.second;
+        first = false;
+    }
+    ostr << "}";
+    if (_allocations) {
+        ostr << ",\"phases\":{";
+        for (int i = 0; i < Phases; ++i) {
+            ostr << (i > 0 ? "," : "") << "\"" << phases[i] << "\":"
+                 << "{\"allocations\":" << _allocations_by_phase[i]
+                 << ",\"bytes\":" << _bytes_by_phase[i] << "}";
+        }
+        ostr << "},\"descriptors\":{";
+        for (int i = 0; i < Kinds; ++i) {
+            ostr << (i > 0 ? "," : "") << "\"" << kinds[i] << "\":"
+                 << "{\"allocations\":" << _allocations_by_kind[i]
+                 << ",\"bytes\":" << _bytes_by_kind[i] << "}";
+        }
+        ostr << "}";
+    }
+    ostr << "}";
+}
+
+uint64_t
+Stats::wall()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+uint64_t
+Stats::peak()
+{
+    struct rusage usage;
+    ::getrusage(RUSAGE_SELF, &usage);
+    return uint64_t(usage.ru_maxrss) * 1024;
+}
+
+uint64_t
+Stats::cpu()
+{
+    struct timespec ts;
+    ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return uint64_t(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+Stats::Phase
+Stats::enter(Phase phase)
+{
+    charge();
+    ++_depth;
+    Phase previous = _phase;
+    _phase = phase;
+    return previous;
+}
+
+void
+Stats::leave(Phase previous)
+{
+    charge();
+    --_depth;
+    _phase = previous;
+}
+
+void
+Stats::charge()
+{
+    // The time outside of any timer is not charged.
+    uint64_t wall = Stats::wall();
+    uint64_t cpu = Stats::cpu();
+    if (_depth > 0) {
+        _wall[_phase] += wall - _wall_start;
+        _cpu[_phase] += cpu - _cpu_start;
+    }
+    _wall_start = wall;
+    _cpu_start = cpu;
+}
+
+} // namespace muddoc
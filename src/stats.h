@@ -0,0 +1,432 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#ifndef _MUDDOC_STATS_H_
+#define _MUDDOC_STATS_H_
+
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <string>
+#include <clang-c/Index.h>
+
+namespace muddoc {
+
+/**
+ * @brief Timing and counters of the documentation generation.
+ *
+ * @details
+ * The time is split in phases, like parsing, comment rendering and writing
+ * the output. The time of a phase is exclusive: when a phase is entered
+ * while another one is active, like escaping while rendering a comment, the
+ * time is charged to the inner phase only. Time outside of any timer is not
+ * recorded. Both the wall clock time and the CPU time of the thread are
+ * recorded.
+ *
+ * The memory accounting covers the peak resident set size of the process and
+ * the memory held by the translation units, as reported by clang. When
+ * allocation counting is enabled as well, every allocation through the
+ * global operator new is counted against the active phase and against the
+ * kind of descriptor that is being generated. This requires the replacement
+ * operators of allocation.cpp to be linked into the executable. As these
+ * replace the operators of the clang library too, the allocations of clang
+ * are included, charged to the phase in which clang is called.
+ *
+ * Each thread records into its own statistics, which are combined when the
+ * results are collected, such that threads never contend. The statistics
+ * are only recorded once they have been enabled; otherwise each timer and
+ * counter costs a single test of a flag.
+ */
+class Stats
+{
+public:
+    /**
+     * @brief The phases that time is charged to.
+     */
+    enum Phase {
+        Other,      /**< Anything outside the other phases */
+        Parse,      /**< Parsing the translation unit */
+        Comments,   /**< Looking up and parsing the comments */
+        Render,     /**< Rendering the comments to XML */
+        Pretty,     /**< Pretty-printing declarations */
+        Usr,        /**< Generating USRs */
+        Escape,     /**< Escaping XML text */
+        Serialize,  /**< Serializing descriptors to XML */
+        Write,      /**< Writing the output */
+        Phases      /**< The number of phases */
+    };
+
+    /**
+     * @brief The counters.
+     */
+    enum Counter {
+        CursorsVisited,     /**< The cursors that have been visited */
+        CursorsFiltered,    /**< The cursors rejected by the filter */
+        Namespaces,         /**< The namespace descriptors */
+        Classes,            /**< The class descriptors */
+        Constructors,       /**< The constructor descriptors */
+        Destructors,        /**< The destructor descriptors */
+        Methods,            /**< The method descriptors */
+        Enums,              /**< The enumeration descriptors */
+        EnumConstants,      /**< The enumerator descriptors */
+        CommentsParsed,     /**< The comments that have been parsed */
+        CommentsScanned,    /**< The comments that have been scanned */
+        BytesEscaped,       /**< The bytes passed to the XML escaping */
+        BytesWritten,       /**< The bytes of output written */
+        Counters            /**< The number of counters */
+    };
+
+    /**
+     * @brief The kinds of descriptor that allocations are charged to.
+     */
+    enum Kind {
+        Unowned,        /**< Outside of any descriptor */
+        Namespace,      /**< A namespace descriptor */
+        Class,          /**< A class descriptor */
+        Constructor,    /**< A constructor descriptor */
+        Destructor,     /**< A destructor descriptor */
+        Method,         /**< A method descriptor */
+        Enum,           /**< An enumeration descriptor */
+        EnumConstant,   /**< An enumerator descriptor */
+        Kinds           /**< The number of kinds */
+    };
+
+    /**
+     * @brief Time a phase for the lifetime of the object.
+     *
+     * @details
+     * The phase becomes the active phase of the thread until the object is
+     * destructed, after which the previously active phase resumes.
+     */
+    class Timer
+    {
+    public:
+        /**
+         * @brief Enter a phase.
+         *
+         * @param phase The phase to charge the time to.
+         */
+        Timer(Phase phase)
+            : _stats(enabled() ? &local() : nullptr)
+        {
+            if (_stats != nullptr) {
+                _previous = _stats->enter(phase);
+            }
+        }
+
+        /**
+         * @brief Leave the phase.
+         */
+        ~Timer()
+        {
+            if (_stats != nullptr) {
+                _stats->leave(_previous);
+            }
+        }
+
+        /** Non-copyable */
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+
+    private:
+        /* The statistics to charge to, or nullptr if not enabled */
+        Stats* _stats;
+
+        /* The phase to resume */
+        Phase _previous;
+    };
+
+    /**
+     * @brief Charge allocations to a kind of descriptor for the lifetime of
+     * the object.
+     *
+     * @details
+     * The kind is the active kind of the thread until the object is
+     * destructed, after which the previously active kind resumes. This
+     * includes the allocations of any nested descriptors that are not
+     * charged to a kind of their own.
+     */
+    class Owner
+    {
+    public:
+        /**
+         * @brief Enter a kind of descriptor.
+         *
+         * @param kind The kind to charge the allocations to.
+         */
+        Owner(Kind kind)
+            : _stats(_allocations ? &local() : nullptr)
+        {
+            if (_stats != nullptr) {
+                _previous = _stats->_kind;
+                _stats->_kind = kind;
+            }
+        }
+
+        /**
+         * @brief Leave the kind of descriptor.
+         */
+        ~Owner()
+        {
+            if (_stats != nullptr) {
+                _stats->_kind = _previous;
+            }
+        }
+
+        /** Non-copyable */
+        Owner(const Owner&) = delete;
+        Owner& operator=(const Owner&) = delete;
+
+    private:
+        /* The statistics to charge to, or nullptr if not counting */
+        Stats* _stats;
+
+        /* The kind to resume */
+        Kind _previous;
+    };
+
+    /**
+     * @brief Create empty statistics.
+     */
+    Stats();
+
+    /**
+     * @brief Enable recording the statistics.
+     *
+     * @details
+     * This should be called before any other thread is started.
+     */
+    static void enable() { _enabled = true; }
+
+    /**
+     * @brief Verify if the statistics are recorded.
+     *
+     * @return True if the statistics are recorded.
+     */
+    static bool enabled() { return _enabled; }
+
+    /**
+     * @brief Enable the memory accounting.
+     *
+     * @details
+     * This should be called before any other thread is started. It also
+     * enables the recording of the other statistics.
+     *
+     * @param allocations True to count the allocations as well.
+     */
+    static void memory(bool allocations)
+    {
+        _enabled = true;
+        _memory = true;
+        _allocations = allocations;
+    }
+
+    /**
+     * @brief Verify if the memory accounting is enabled.
+     *
+     * @return True if the memory accounting is enabled.
+     */
+    static bool memory() { return _memory; }
+
+    /**
+     * @brief Count an allocation of this thread.
+     *
+     * @details
+     * This is called by the replacement operator new and must not allocate
+     * memory itself.
+     *
+     * @param size The size of the allocated block.
+     */
+    static void allocated(size_t size)
+    {
+        if (_allocations) {
+            Stats& stats = local();
+            ++stats._allocations_by_phase[stats._phase];
+            stats._bytes_by_phase[stats._phase] += size;
+            ++stats._allocations_by_kind[stats._kind];
+            stats._bytes_by_kind[stats._kind] += size;
+        }
+    }
+
+    /**
+     * @brief Record the memory held by a translation unit.
+     *
+     * @details
+     * The largest amount of each kind of resource across all translation
+     * units is retained.
+     *
+     * @param unit The translation unit.
+     */
+    static void usage(CXTranslationUnit unit);
+
+    /**
+     * @brief Get the statistics of this thread.
+     *
+     * @details
+     * Unless other statistics have been set for the thread, these are the
+     * statistics of the thread itself.
+     *
+     * @return The statistics that this thread records into.
+     */
+    static Stats& local();
+
+    /**
+     * @brief Set the statistics of this thread.
+     *
+     * @details
+     * This must not be called while a @c Timer is active.
+     *
+     * @param stats The statistics to record into, or @c nullptr to record
+     * into the statistics of the thread itself.
+     */
+    static void local(Stats* stats);
+
+    /**
+     * @brief Increment a counter of this thread.
+     *
+     * @param counter The counter to increment.
+     * @param amount The amount to increment by.
+     */
+    static void count(Counter counter, uint64_t amount = 1)
+    {
+        if (_enabled) {
+            local()._counters[counter] += amount;
+        }
+    }
+
+    /**
+     * @brief Add other statistics to these statistics.
+     *
+     * @param other The statistics to add.
+     */
+    void add(const Stats& other);
+
+    /**
+     * @brief Get the wall clock time of each phase so far.
+     *
+     * @details
+     * The time of the active phase is charged up to now, such that the
+     * difference of two snapshots is the time spent in between.
+     *
+     * @param wall The wall clock time of each phase in nanoseconds.
+     */
+    void snapshot(uint64_t (&wall)[Phases]);
+
+    /**
+     * @brief Output the statistics as a human readable table.
+     *
+     * @param ostr The stream to output to.
+     * @param elapsed The elapsed wall clock time of the process in seconds.
+     */
+    void text(std::ostream& ostr, double elapsed) const;
+
+    /**
+     * @brief Output the statistics in JSON.
+     *
+     * @param ostr The stream to output to.
+     * @param elapsed The elapsed wall clock time of the process in seconds.
+     */
+    void json(std::ostream& ostr, double elapsed) const;
+
+    /**
+     * @brief Get the current wall clock time.
+     *
+     * @return The time from a monotonic clock in nanoseconds.
+     */
+    static uint64_t wall();
+
+    /**
+     * @brief Get the current CPU time of the thread.
+     *
+     * @return The CPU time of the calling thread in nanoseconds.
+     */
+    static uint64_t cpu();
+
+    /**
+     * @brief Get the peak resident set size of the process.
+     *
+     * @return The peak resident set size in bytes.
+     */
+    static uint64_t peak();
+
+private:
+    /* Make a phase active and return the phase that was active */
+    Phase enter(Phase phase);
+
+    /* Resume the phase that was active before the current one */
+    void leave(Phase previous);
+
+    /* Charge the time since the last change to the active phase */
+    void charge();
+
+    /* Output the memory accounting */
+    void text_memory(std::ostream& ostr) const;
+    void json_memory(std::ostream& ostr) const;
+
+    /* True if the statistics are recorded */
+    static bool _enabled;
+
+    /* True if the memory is accounted for */
+    static bool _memory;
+
+    /* True if the allocations are counted */
+    static bool _allocations;
+
+    /* The wall clock time of each phase, in nanoseconds */
+    uint64_t _wall[Phases];
+
+    /* The CPU time of each phase, in nanoseconds */
+    uint64_t _cpu[Phases];
+
+    /* The counters */
+    uint64_t _counters[Counters];
+
+    /* The number and size of the allocations per phase */
+    uint64_t _allocations_by_phase[Phases];
+    uint64_t _bytes_by_phase[Phases];
+
+    /* The number and size of the allocations per kind of descriptor */
+    uint64_t _allocations_by_kind[Kinds];
+    uint64_t _bytes_by_kind[Kinds];
+
+    /* The active kind of descriptor */
+    Kind _kind;
+
+    /* The largest amount of each resource held by a translation unit */
+    std::map<std::string, uint64_t> _unit;
+
+    /* The number of active timers */
+    unsigned _depth;
+
+    /* The active phase and the times at which it became active */
+    Phase _phase;
+    uint64_t _wall_start;
+    uint64_t _cpu_start;
+};
+
+} // namespace muddoc
+
+#endif /* _MUDDOC_STATS_H_ */
@@ -0,0 +1,205 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#include <cstring>
+#include <sstream>
+#include <unordered_set>
+#include "symbols.h"
+#include "utility.h"
+
+namespace muddoc {
+
+void
+SymbolIndex::add(const std::string& qualified, const std::string& usr)
+{
+    if (!qualified.empty() && !usr.empty()) {
+        _symbols.emplace(qualified, usr);
+    }
+}
+
+const std::string*
+SymbolIndex::find(const std::string& name, const std::string& scope) const
+{
+    // A name in the global scope
+    if (name.compare(0, 2, "::") == 0) {
+        auto iter = _symbols.find(name.substr(2));
+        return iter != _symbols.end() ? &iter->second : nullptr;
+    }
+
+    // Look up the name in the scope and each of its enclosing scopes.
+    std::string prefix = scope;
+    while (true) {
+        auto iter = _symbols.find(prefix.empty() ? name : prefix + "::" + name);
+        if (iter != _symbols.end()) {
+            return &iter->second;
+        }
+        if (prefix.empty()) {
+            return nullptr;
+        }
+        size_t pos = prefix.rfind("::");
+        prefix.resize(pos == std::string::npos ? 0 : pos);
+    }
+}
+
+/* Return the value of an attribute in a start tag, or an empty string. */
+static std::string
+attribute(const std::string& tag, const char* name)
+{
+    std::string key = std::string(" ") + name + "=\"";
+    size_t pos = tag.find(key);
+    if (pos == std::string::npos) {
+        return std::string();
+    }
+    pos += key.size();
+    return unescape(tag.substr(pos, tag.find('"', pos) - pos));
+}
+
+void
+SymbolIndex::resolve(const std::string& xml, std::ostream& ostr,
+        std::vector<std::string>& unresolved) const
+{
+    static const char ref[] = "<ref ";
+    static const char cdata[] = "<![CDATA[";
+    std::unordered_set<std::string> reported;
+    size_t pos = 0;
+    while (pos < xml.size()) {
+        // Copy everything up to the next markup that may contain a reference.
+        size_t next = xml.find('<', pos);
+        if (next == std::string::npos) {
+            ostr.write(xml.data() + pos, xml.size() - pos);
+            break;
+        }
+        ostr.write(xml.data() + pos, next - pos);
+        pos = next;
+
+        // Copy a CDATA section as is, it may contain anything.
+        if (xml.compare(pos, sizeof(cdata) - 1, cdata) == 0) {
+            size_t end = xml.find("]]>", pos);
+            end = (end == std::string::npos) ? xml.size() : end + 3;
+            ostr.write(xml.data() + pos, end - pos);
+            pos = end;
+            continue;
+        }
+
+        // Copy any other markup up to the end of the tag.
+        size_t end = xml.find('>', pos);
+        end = (end == std::string::npos) ? xml.size() : end + 1;
+        if (xml.compare(pos, sizeof(ref) - 1, ref) != 0) {
+            ostr.write(xml.data() + pos, end - pos);
+            pos = end;
+            continue;
+        }
+
+        // Resolve an unresolved reference.
+        std::string tag = xml.substr(pos, end - pos);
+        pos = end;
+        std::string name = attribute(tag, "name");
+        if (tag.find(" scope=\"") == std::string::npos) {
+            ostr << tag;
+            continue;
+        }
+        const std::string* usr = find(name, attribute(tag, "scope"));
+        if (usr == nullptr) {
+            if (reported.insert(name).second) {
+                unresolved.push_back(name);
+            }
+            ostr << tag;
+            continue;
+        }
+        ostr << "<ref name=\"" << escape(name) << "\""
+             << " usr=\"" << escape(*usr) << "\">";
+    }
+}
+
+void
+SymbolIndex::strip(const std::string& xml, std::string& text,
+        std::vector<Reference>& references,
+        std::vector<std::string>& unresolved) const
+{
+    static const char ref[] = "<ref ";
+    static const char cdata[] = "<![CDATA[";
+    std::unordered_set<std::string> reported;
+    size_t pos = 0;
+    while (pos < xml.size()) {
+        // Copy the character data up to the next markup.
+        size_t next = xml.find('<', pos);
+        if (next == std::string::npos) {
+            text += unescape(xml.substr(pos));
+            break;
+        }
+        text += unescape(xml.substr(pos, next - pos));
+        pos = next;
+
+        // Copy the content of a CDATA section as is.
+        if (xml.compare(pos, sizeof(cdata) - 1, cdata) == 0) {
+            pos += sizeof(cdata) - 1;
+            size_t end = xml.find("]]>", pos);
+            end = (end == std::string::npos) ? xml.size() : end;
+            text.append(xml, pos, end - pos);
+            pos = (end == xml.size()) ? end : end + 3;
+            continue;
+        }
+
+        // Drop any other markup, only the references are retained.
+        size_t end = xml.find('>', pos);
+        end = (end == std::string::npos) ? xml.size() : end + 1;
+        if (xml.compare(pos, sizeof(ref) - 1, ref) != 0) {
+            pos = end;
+            continue;
+        }
+        std::string tag = xml.substr(pos, end - pos);
+        pos = end;
+        Reference reference;
+        reference.name = attribute(tag, "name");
+        reference.usr = attribute(tag, "usr");
+        if (tag.find(" scope=\"") != std::string::npos) {
+            const std::string* usr = find(reference.name,
+                    attribute(tag, "scope"));
+            if (usr != nullptr) {
+                reference.usr = *usr;
+            }
+            else
+            if (reported.insert(reference.name).second) {
+                unresolved.push_back(reference.name);
+            }
+        }
+        references.push_back(std::move(reference));
+    }
+}
+
+std::string
+SymbolIndex::summary(const std::vector<std::string>& unresolved)
+{
+    std::stringstream sstr;
+    sstr << unresolved.size() << " unresolved reference"
+         << (unresolved.size() == 1 ? "" : "s") << ": ";
+    for (size_t i = 0; i < unresolved.size(); ++i) {
+        sstr << (i > 0 ? ", " : "") << unresolved[i];
+    }
+    return sstr.str();
+}
+
+} // namespace muddoc
@@ -0,0 +1,159 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#ifndef _MUDDOC_SYMBOLS_H_
+#define _MUDDOC_SYMBOLS_H_
+
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace muddoc {
+
+/**
+ * @brief Index of all documented symbols.
+ *
+ * @details
+ * The index maps the qualified name of each documented symbol to its USR. It
+ * is built before the declarations are described and is used to resolve the
+ * cross-references in the comments, like the @c ref and @c see commands, as
+ * the descriptions are output.
+ *
+ * A cross-reference is emitted by the descriptors in unresolved form, with
+ * the name as written in the comment and the qualified name of the
+ * declaration that contains the reference:
+ *
+ * @code
+ * <ref name="NAME" scope="SCOPE">TEXT</ref>
+ * @endcode
+ *
+ * A resolved reference replaces the scope with the USR of the symbol:
+ *
+ * @code
+ * <ref name="NAME" usr="USR">TEXT</ref>
+ * @endcode
+ */
+class SymbolIndex
+{
+public:
+    /**
+     * @brief A cross-reference in a text.
+     */
+    struct Reference
+    {
+        /** The name of the symbol, as written in the comment */
+        std::string name;
+
+        /** The USR of the symbol, or empty if it cannot be resolved */
+        std::string usr;
+    };
+
+    /**
+     * @brief Create an empty index.
+     */
+    SymbolIndex() = default;
+
+    /**
+     * @brief Add a symbol.
+     *
+     * @details
+     * Add a symbol to the index. If there is more than one symbol with the
+     * same qualified name, like overloaded methods, the first one is
+     * retained.
+     *
+     * @param qualified The qualified name of the symbol.
+     * @param usr The USR of the symbol.
+     */
+    void add(const std::string& qualified, const std::string& usr);
+
+    /**
+     * @brief Look up a symbol.
+     *
+     * @details
+     * Look up a symbol the way C++ name lookup does. The @p name is first
+     * looked up as a member of @p scope, then as a member of each enclosing
+     * scope and finally in the global scope. A name that starts with "::"
+     * is only looked up in the global scope.
+     *
+     * @param name The name of the symbol, which may be qualified.
+     * @param scope The qualified name of the scope to start the lookup from.
+     * @return The USR of the symbol, or @c nullptr if it cannot be found.
+     */
+    const std::string* find(const std::string& name,
+            const std::string& scope) const;
+
+    /**
+     * @brief Resolve all cross-references.
+     *
+     * @details
+     * Copy the XML text, like a rendered comment, to the stream, resolving
+     * all the unresolved cross-references that can be found in the index.
+     * The names that cannot be resolved are left unresolved and are added to
+     * @p unresolved, once per name.
+     *
+     * @param xml The XML text.
+     * @param ostr The stream to output the resolved document to.
+     * @param unresolved The names of the unresolved references.
+     */
+    void resolve(const std::string& xml, std::ostream& ostr,
+            std::vector<std::string>& unresolved) const;
+
+    /**
+     * @brief Convert to plain text and resolve all cross-references.
+     *
+     * @details
+     * Convert the XML text, like a rendered comment, to plain text, where
+     * the markup is dropped and the character data is unescaped. Each
+     * cross-reference is added to @p references, with its USR if it can be
+     * found in the index. The names that cannot be resolved are added to
+     * @p unresolved, once per name.
+     *
+     * @param xml The XML text.
+     * @param text The plain text to append to.
+     * @param references The cross-references in the text.
+     * @param unresolved The names of the unresolved references.
+     */
+    void strip(const std::string& xml, std::string& text,
+            std::vector<Reference>& references,
+            std::vector<std::string>& unresolved) const;
+
+    /**
+     * @brief Describe the unresolved references.
+     *
+     * @param unresolved The names of the unresolved references.
+     * @return A single line summary of the unresolved references.
+     */
+    static std::string summary(const std::vector<std::string>& unresolved);
+
+private:
+    /* The USR of each symbol by its qualified name */
+    std::unordered_map<std::string, std::string> _symbols;
+};
+
+} // namespace muddoc
+
+#endif /* _MUDDOC_SYMBOLS_H_ */
@@ -24,6 +24,10 @@
  * ++ end-license-description ++
  */
 
+#include <cstring>
+#include <vector>
+#include <clang/AST/DeclCXX.h>
+#include "stats.h"
 #include "utility.h"
 
 namespace muddoc {
@@ -45,6 +49,8 @@ str(const llvm::StringRef& obj)
 std::string
 escape(const std::string& str)
 {
+    Stats::Timer timer(Stats::Escape);
+    Stats::count(Stats::BytesEscaped, str.size());
     std::string result;
     for (auto ch: str) {
          switch (ch) {
@@ -71,4 +77,95 @@ escape(const std::string& str)
     return result;
 }
 
+std::string
+unescape(const std::string& str)
+{
+    static const struct {
+        const char* entity;
+        char ch;
+    } entities[] = {
+        { "&apos;", '\'' },
+        { "&quot;", '\"' },
+        { "&lt;", '<' },
+        { "&gt;", '>' },
+        { "&amp;", '&' }
+    };
+    std::string result;
+    for (size_t pos = 0; pos < str.size(); ++pos) {
+        char ch = str[pos];
+        if (ch == '&') {
+            for (const auto& entry: entities) {
+                size_t len = ::strlen(entry.entity);
+                if (str.compare(pos, len, entry.entity) == 0) {
+                    ch = entry.ch;
+                    pos += len - 1;
+                    break;
+                }
+            }
+        }
+        result += ch;
+    }
+    return result;
+}
+
+std::string
+quote(const std::string& str)
+{
+    static const char hex[] = "0123456789abcdef";
+    std::string result = "\"";
+    for (auto ch: str) {
+        switch (ch) {
+            case '\"':
+                result += "\\\"";
+                break;
+            case '\\':
+                result += "\\\\";
+                break;
+            case '\n':
+                result += "\\n";
+                break;
+            case '\t':
+                result += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(ch) < 0x20) {
+                    result += "\\u00";
+                    result += hex[(ch >> 4) & 0xf];
+                    result += hex[ch & 0xf];
+                }
+                else {
+                    result += ch;
+                }
+                break;
+        }
+    }
+    result += "\"";
+    return result;
+}
+
+std::string
+scope(const clang::Decl* decl, const std::string& separator)
+{
+    // Collect the names from the innermost to the outermost scope.
+    std::vector<std::string> names;
+    for (auto context = decl->getDeclContext();
+         context != nullptr;
+         context = context->getParent())
+    {
+        if (auto ns = llvm::dyn_cast<clang::NamespaceDecl>(context)) {
+            names.push_back(ns->getNameAsString());
+        }
+        else
+        if (auto record = llvm::dyn_cast<clang::CXXRecordDecl>(context)) {
+            names.push_back(record->getNameAsString());
+        }
+    }
+
+    std::string result;
+    for (auto iter = names.rbegin(); iter != names.rend(); ++iter) {
+        result += *iter + separator;
+    }
+    return result;
+}
+
 } // namespace muddoc
@@ -29,6 +29,7 @@
 
 #include <string>
 #include <clang-c/CXString.h>
+#include <clang/AST/Decl.h>
 #include <llvm/ADT/StringRef.h>
 
 namespace muddoc {
@@ -70,6 +71,47 @@ std::string str(const llvm::StringRef& obj);
  */
 std::string escape(const std::string& str);
 
+/**
+ * @brief Revert XML character escaping.
+ *
+ * @details
+ * Replace the 5 predefined XML entities that are produced by @c escape by the
+ * characters they represent.
+ *
+ * @param str The string to unescape.
+ * @return The unescaped copy of @p str.
+ */
+std::string unescape(const std::string& str);
+
+/**
+ * @brief Quote a string in JSON.
+ *
+ * @details
+ * Return the string as a JSON string literal, including the surrounding
+ * double quotes. The double quote, the backslash and all control characters
+ * are escaped.
+ *
+ * @param str The string to quote.
+ * @return The JSON string literal of @p str.
+ */
+std::string quote(const std::string& str);
+
+/**
+ * @brief Return the enclosing scope of a declaration.
+ *
+ * @details
+ * Return the names of all the namespaces and classes that enclose the
+ * declaration, starting with the outermost one. Each name is followed by the
+ * @p separator. The declaration itself is not part of the scope. For example,
+ * the scope of the method @c acme::net::Socket::open would be
+ * "acme::net::Socket::" when using "::" as the separator.
+ *
+ * @param decl The declaration to return the scope of.
+ * @param separator The separator to add after each name.
+ * @return The enclosing scope of @p decl.
+ */
+std::string scope(const clang::Decl* decl, const std::string& separator);
+
 } // namespace muddoc
 
 #endif /* _MUDDOC_UTILITY_H_ */
@@ -26,6 +26,8 @@
 
 #include <functional>
 #include <sstream>
+#include <string>
+#include <vector>
 #include <clang-c/Documentation.h>
 #include <clang-c/Index.h>
 #include <clang/AST/Comment.h>
@@ -34,6 +36,11 @@
 #include <clang/AST/DeclCXX.h>
 #include <clang/AST/DeclTemplate.h>
 #include "descriptor.h"
+#include "profile.h"
+#include "search.h"
+#include "sink.h"
+#include "stats.h"
+#include "symbols.h"
 #include "visitor.h"
 #include "utility.h"
 #include "warn_error.h"
@@ -57,55 +64,228 @@ FileFilter::match(const CXCursor& cursor) const
     return strcmp(clang_getCString(filename), _path.c_str()) == 0;
 }
 
+/* Check whether the cursor is a scope that is documented with its members */
+static bool
+enclosing(CXCursorKind kind)
+{
+    switch (kind) {
+        case CXCursor_Namespace:
+        case CXCursor_StructDecl:
+        case CXCursor_UnionDecl:
+        case CXCursor_ClassDecl:
+        case CXCursor_EnumDecl:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/* The sink of a visitor that is not generating, it ignores all events */
+static Sinks none;
+
 struct Visitor::ClientData
 {
     const Visitor& visitor;
-    std::ostream& ostr;
+    std::ostream* ostr;
+    Fingerprint* fingerprint;
+    bool indexing;
 };
 
-static CXChildVisitResult
-__visit(CXCursor cursor, CXCursor parent, CXClientData client_data)
+CXChildVisitResult
+Visitor::visiting(CXCursor cursor, CXCursor parent, CXClientData client_data)
 {
     auto data = (struct Visitor::ClientData*)client_data;
     return data->visitor.visit(cursor, parent, data);
 }
 
+struct Visitor::Query
+{
+    ClientData& data;
+    const std::string& symbol;
+    bool usr;
+    std::vector<std::string> path;
+    size_t depth;
+    size_t found;
+};
+
+CXChildVisitResult
+Visitor::querying(CXCursor cursor, CXCursor parent, CXClientData client_data)
+{
+    auto query = (struct Visitor::Query*)client_data;
+    return query->data.visitor.query(cursor, parent, query);
+}
+
 Visitor::Visitor(CXTranslationUnit unit)
-    : _unit(unit)
+    : _unit(unit), _sink(&none), _search(nullptr), _minimal(false),
+      _lint(false)
 {
     _filter.reset(new AnyFilter());
 }
 
 void
-Visitor::generate(std::ostream& ostr, const Filter& filter)
+Visitor::generate(std::ostream& ostr, const Filter& filter,
+        const std::string& file)
+{
+    if (!_minimal) {
+        XmlSink xml(ostr);
+        generate(xml, filter, file);
+        return;
+    }
+
+    // The symbol records have no cross-references to resolve, so they are
+    // output as they are visited.
+    _filter.reset(filter.clone());
+    ClientData data { *this, &ostr, nullptr, false };
+    document(ostr, file);
+    CXCursor cursor = clang_getTranslationUnitCursor(_unit);
+    clang_visitChildren(cursor, visiting, (CXClientData)&data);
+    ostr << "</doc>";
+}
+
+void
+Visitor::generate(Sink& sink, const Filter& filter, const std::string& file)
 {
     _filter.reset(filter.clone());
-    ClientData data { *this, ostr };
-    ostr << "<doc>";
+    _sink = &sink;
+    Fingerprint members;
+    ClientData data { *this, nullptr,
+            Descriptor::fingerprints() && !_lint ? &members : nullptr, false };
     CXCursor cursor = clang_getTranslationUnitCursor(_unit);
-    clang_visitChildren(cursor, __visit, (CXClientData)&data);
+
+    // Index the symbols before describing them, such that the sink can
+    // resolve the cross-references as the descriptions arrive. This visits
+    // the declarations twice and computes their USRs twice, which is cheap
+    // compared to describing them.
+    if (!_lint) {
+        ClientData index { *this, nullptr, nullptr, true };
+        clang_visitChildren(cursor, visiting, (CXClientData)&index);
+    }
+    sink.begin(file, _symbols);
+    clang_visitChildren(cursor, visiting, (CXClientData)&data);
+    sink.end(file, data.fingerprint != nullptr ? members.value() : 0);
+    _sink = &none;
+}
+
+size_t
+Visitor::query(std::ostream& ostr, const Filter& filter,
+        const std::string& file, const std::string& symbol, bool usr)
+{
+    // Only the references to the generated symbols can be resolved, any
+    // other reference is expected to remain unresolved.
+    if (!_minimal) {
+        XmlSink xml(ostr, false);
+        return query(xml, filter, file, symbol, usr);
+    }
+
+    _filter.reset(filter.clone());
+    ClientData data { *this, &ostr, nullptr, false };
+    document(ostr, file);
+    size_t found = lookup(data, symbol, usr);
     ostr << "</doc>";
+    return found;
 }
 
-std::string
-Visitor::generate(CXCursor cursor) const
+size_t
+Visitor::query(Sink& sink, const Filter& filter, const std::string& file,
+        const std::string& symbol, bool usr)
 {
-    std::stringstream ostr;
-    ClientData data { *this, ostr};
-    clang_visitChildren(cursor, __visit, (CXClientData)&data);
-    return ostr.str();
+    _filter.reset(filter.clone());
+    _sink = &sink;
+    Fingerprint members;
+    ClientData data { *this, nullptr,
+            Descriptor::fingerprints() && !_lint ? &members : nullptr, false };
+    if (!_lint) {
+        // Only the queried symbols are indexed, see generate().
+        ClientData index { *this, nullptr, nullptr, true };
+        lookup(index, symbol, usr);
+    }
+    sink.begin(file, _symbols);
+    size_t found = lookup(data, symbol, usr);
+    sink.end(file, data.fingerprint != nullptr ? members.value() : 0);
+    _sink = &none;
+    return found;
+}
+
+void
+Visitor::generate(const NamespaceDescriptor& scope, Fingerprint* members) const
+{
+    if (!_lint) {
+        Stats::Timer timer(Stats::Serialize);
+        _sink->begin(scope);
+        comments(scope, {}, std::string());
+    }
+    ClientData data { *this, nullptr, members, false };
+    clang_visitChildren(scope.cursor(), visiting, (CXClientData)&data);
+}
+
+void
+Visitor::generate(const ClassDescriptor& scope, Fingerprint* members) const
+{
+    if (!_lint) {
+        Stats::Timer timer(Stats::Serialize);
+        _sink->begin(scope);
+        comments(scope, scope.params(), std::string());
+    }
+    ClientData data { *this, nullptr, members, false };
+    clang_visitChildren(scope.cursor(), visiting, (CXClientData)&data);
+}
+
+void
+Visitor::generate(const EnumDescriptor& scope, Fingerprint* members) const
+{
+    if (!_lint) {
+        Stats::Timer timer(Stats::Serialize);
+        _sink->begin(scope);
+        comments(scope, {}, std::string());
+    }
+    ClientData data { *this, nullptr, members, false };
+    clang_visitChildren(scope.cursor(), visiting, (CXClientData)&data);
+}
+
+size_t
+Visitor::lookup(struct ClientData& data, const std::string& symbol,
+        bool usr) const
+{
+    // Split a qualified name in the names of its enclosing scopes.
+    Query query { data, symbol, usr, {}, 0, 0 };
+    if (!usr) {
+        size_t pos = symbol.compare(0, 2, "::") == 0 ? 2 : 0;
+        for (size_t end; (end = symbol.find("::", pos)) != std::string::npos;
+             pos = end + 2)
+        {
+            query.path.push_back(symbol.substr(pos, end - pos));
+        }
+        query.path.push_back(symbol.substr(pos));
+    }
+
+    CXCursor cursor = clang_getTranslationUnitCursor(_unit);
+    clang_visitChildren(cursor, querying, (CXClientData)&query);
+    return query.found;
+}
+
+void
+Visitor::document(std::ostream& ostr, const std::string& file) const
+{
+    ostr << "<doc file=\"" << escape(file) << "\">";
 }
 
 CXChildVisitResult
 Visitor::visit(CXCursor cursor, CXCursor parent, struct ClientData* data) const
 {
-    // Only process if it passes the filter
-    if (!_filter->match(cursor)) {
+    // Only process if it passes the filter. A scope that does not match
+    // itself is still generated if any of its members may match, otherwise
+    // it is skipped as a whole.
+    Stats::count(Stats::CursorsVisited);
+    Filter::Match match = _filter->test(cursor);
+    CXCursorKind kind = clang_getCursorKind(cursor);
+    if (match == Filter::Skip
+            || (match == Filter::Enter && !enclosing(kind)))
+    {
+        Stats::count(Stats::CursorsFiltered);
         return CXChildVisit_Continue;
     }
 
     // Consider declarations we care to document about.
-    CXCursorKind kind = clang_getCursorKind(cursor);
     switch (kind) {
         case CXCursor_PreprocessingDirective:
         case CXCursor_MacroDefinition:
@@ -182,11 +362,15 @@ Visitor::visit(CXCursor cursor, CXCursor parent, struct ClientData* data) const
             // Ignore
             break;
         default: {
+           Diagnostics& diag = diagnostics();
+           if (!diag.enabled(Diagnostics::Note)) {
+               break;
+           }
            std::stringstream sstr;
            sstr << "Unsupported declaration type "
                 << str(clang_getCursorKindSpelling(kind)) << " for '"
                 << str(clang_getCursorSpelling(cursor)) << "'";
-           warn(cursor, sstr.str());
+           diag.add(Diagnostics::Note, "unsupported-decl", cursor, sstr.str());
            break; }
     }
     return CXChildVisit_Continue;
@@ -201,9 +385,25 @@ Visitor::generate(const CXCursor& cursor,
     if (decl->getAccess() == clang::AccessSpecifier::AS_private) {
         return;
     }
+    if (_minimal || data->indexing) {
+        symbol(cursor, decl, "namespace", true, data);
+        return;
+    }
+    Profile::Scope scope(cursor, "namespace");
+    Stats::Owner owner(Stats::Namespace);
     NamespaceDescriptor descriptor(cursor, decl, *this);
+    Stats::count(Stats::Namespaces);
+
+    // The scope and its members are output while it is generated, so its
+    // size is taken before.
+    scope.output(*_sink, descriptor.qualified());
     descriptor.generate();
-    data->ostr << descriptor;
+    if (_lint) {
+        return;
+    }
+    record(descriptor, "namespace", data);
+    Stats::Timer timer(Stats::Serialize);
+    _sink->end(descriptor);
 }
 
 void
@@ -219,9 +419,25 @@ Visitor::generate(const CXCursor& cursor,
     if (!decl->isThisDeclarationADefinition()) {
         return;
     }
+    if (_minimal || data->indexing) {
+        symbol(cursor, decl, "class", true, data);
+        return;
+    }
+    Profile::Scope scope(cursor, "class");
+    Stats::Owner owner(Stats::Class);
     ClassDescriptor descriptor(cursor, decl, *this);
+    Stats::count(Stats::Classes);
+
+    // The scope and its members are output while it is generated, so its
+    // size is taken before.
+    scope.output(*_sink, descriptor.qualified());
     descriptor.generate();
-    data->ostr << descriptor;
+    if (_lint) {
+        return;
+    }
+    record(descriptor, "class", data);
+    Stats::Timer timer(Stats::Serialize);
+    _sink->end(descriptor);
 }
 
 void
@@ -254,9 +470,20 @@ Visitor::generate(const CXCursor& cursor,
     if (decl->getAccess() == clang::AccessSpecifier::AS_private) {
         return;
     }
+    if (_minimal || data->indexing) {
+        symbol(cursor, decl, "enum", true, data);
+        return;
+    }
+    Stats::Owner owner(Stats::Enum);
     EnumDescriptor descriptor(cursor, decl, *this);
+    Stats::count(Stats::Enums);
     descriptor.generate();
-    data->ostr << descriptor;
+    if (_lint) {
+        return;
+    }
+    record(descriptor, "enum", data);
+    Stats::Timer timer(Stats::Serialize);
+    _sink->end(descriptor);
 }
 
 void
@@ -268,9 +495,21 @@ Visitor::generate(const CXCursor& cursor,
     if (decl->getAccess() == clang::AccessSpecifier::AS_private) {
         return;
     }
+    if (_minimal || data->indexing) {
+        symbol(cursor, decl, "value", false, data);
+        return;
+    }
+    Stats::Owner owner(Stats::EnumConstant);
     EnumConstantDescriptor descriptor(cursor, decl);
+    Stats::count(Stats::EnumConstants);
     descriptor.generate();
-    data->ostr << descriptor;
+    if (_lint) {
+        return;
+    }
+    record(descriptor, "value", data);
+    Stats::Timer timer(Stats::Serialize);
+    _sink->value(descriptor);
+    comments(descriptor, {}, std::string());
 }
 
 void
@@ -282,9 +521,23 @@ Visitor::generate(const CXCursor& cursor,
     if (decl->getAccess() == clang::AccessSpecifier::AS_private) {
         return;
     }
+    if (_minimal || data->indexing) {
+        symbol(cursor, decl, "method", false, data);
+        return;
+    }
+    Profile::Scope scope(cursor, "method");
+    Stats::Owner owner(Stats::Method);
     MethodDescriptor descriptor(cursor, decl);
+    Stats::count(Stats::Methods);
     descriptor.generate();
-    data->ostr << descriptor;
+    if (_lint) {
+        return;
+    }
+    record(descriptor, "method", data);
+    Stats::Timer timer(Stats::Serialize);
+    scope.output(*_sink, descriptor.qualified());
+    _sink->method(descriptor);
+    comments(descriptor, descriptor.params(), descriptor.returns());
 }
 
 void
@@ -296,9 +549,23 @@ Visitor::generate(const CXCursor& cursor,
     if (decl->getAccess() == clang::AccessSpecifier::AS_private) {
         return;
     }
+    if (_minimal || data->indexing) {
+        symbol(cursor, decl, "constructor", false, data);
+        return;
+    }
+    Profile::Scope scope(cursor, "constructor");
+    Stats::Owner owner(Stats::Constructor);
     ConstructorDescriptor descriptor(cursor, decl);
+    Stats::count(Stats::Constructors);
     descriptor.generate();
-    data->ostr << descriptor;
+    if (_lint) {
+        return;
+    }
+    record(descriptor, "constructor", data);
+    Stats::Timer timer(Stats::Serialize);
+    scope.output(*_sink, descriptor.qualified());
+    _sink->method(descriptor);
+    comments(descriptor, descriptor.params(), std::string());
 }
 
 void
@@ -310,9 +577,23 @@ Visitor::generate(const CXCursor& cursor,
     if (decl->getAccess() == clang::AccessSpecifier::AS_private) {
         return;
     }
+    if (_minimal || data->indexing) {
+        symbol(cursor, decl, "destructor", false, data);
+        return;
+    }
+    Profile::Scope scope(cursor, "destructor");
+    Stats::Owner owner(Stats::Destructor);
     DestructorDescriptor descriptor(cursor, decl);
+    Stats::count(Stats::Destructors);
     descriptor.generate();
-    data->ostr << descriptor;
+    if (_lint) {
+        return;
+    }
+    record(descriptor, "destructor", data);
+    Stats::Timer timer(Stats::Serialize);
+    scope.output(*_sink, descriptor.qualified());
+    _sink->method(descriptor);
+    comments(descriptor, descriptor.params(), std::string());
 }
 
 void
@@ -329,4 +610,128 @@ Visitor::generate(const CXCursor& cursor,
 {
 }
 
+void
+Visitor::record(const Descriptor& descriptor, const char* kind,
+        struct ClientData* data) const
+{
+    if (data->fingerprint != nullptr) {
+        data->fingerprint->add(descriptor.hash());
+    }
+    if (_search != nullptr) {
+        _search->add(descriptor.name(), descriptor.qualified(), kind,
+                descriptor.usr(), descriptor.brief());
+    }
+}
+
+void
+Visitor::comments(const Descriptor& descriptor,
+        const std::vector<ParamDescriptor>& params,
+        const std::string& returns) const
+{
+    for (const auto& param: params) {
+        _sink->param(param);
+    }
+    if (!returns.empty()) {
+        _sink->returns(returns);
+    }
+    _sink->brief(descriptor.brief());
+    _sink->detailed(descriptor.detailed());
+}
+
+void
+Visitor::symbol(const CXCursor& cursor, const clang::NamedDecl* decl,
+        const char* kind, bool members, struct ClientData* data) const
+{
+    // The records are only output to a stream, they have no sink events.
+    if (data->ostr == nullptr && !data->indexing) {
+        return;
+    }
+    std::string usr;
+    {
+        Stats::Timer timer(Stats::Usr);
+        usr = str(clang_getCursorUSR(cursor));
+    }
+
+    // The symbols are indexed before they are described, such that the
+    // references to them can be resolved as soon as they are output.
+    if (data->indexing) {
+        _symbols.add(decl->getQualifiedNameAsString(), usr);
+        if (members) {
+            clang_visitChildren(cursor, visiting, (CXClientData)data);
+        }
+        return;
+    }
+    unsigned line = 0;
+    unsigned column = 0;
+    clang_getSpellingLocation(clang_getCursorLocation(cursor), nullptr,
+            &line, &column, nullptr);
+    if (_search != nullptr) {
+        _search->add(decl->getNameAsString(),
+                decl->getQualifiedNameAsString(), kind, usr, std::string());
+    }
+    {
+        Stats::Timer timer(Stats::Serialize);
+        *data->ostr << "<symbol kind=\"" << kind << "\""
+                    << " name=\"" << escape(decl->getNameAsString()) << "\""
+                    << " usr=\"" << escape(usr) << "\""
+                    << " line=\"" << line << "\""
+                    << " column=\"" << column << "\"";
+        if (!members) {
+            *data->ostr << "/>";
+            return;
+        }
+        *data->ostr << ">";
+    }
+    clang_visitChildren(cursor, visiting, (CXClientData)data);
+    *data->ostr << "</symbol>";
+}
+
+CXChildVisitResult
+Visitor::query(CXCursor cursor, CXCursor parent, struct Query* query) const
+{
+    Stats::count(Stats::CursorsVisited);
+
+    // Match the element on its USR, or on the name at the current depth.
+    bool found = false;
+    if (query->usr) {
+        std::string usr;
+        {
+            Stats::Timer timer(Stats::Usr);
+            usr = str(clang_getCursorUSR(cursor));
+        }
+        if (usr.empty()) {
+            return CXChildVisit_Continue;
+        }
+        // The USR of a member extends the USR of its enclosing scope.
+        found = usr == query->symbol;
+        if (!found && (usr.size() >= query->symbol.size()
+                || query->symbol.compare(0, usr.size(), usr) != 0
+                || query->symbol[usr.size()] != '@'))
+        {
+            return CXChildVisit_Continue;
+        }
+    }
+    else {
+        if (str(clang_getCursorSpelling(cursor)) != query->path[query->depth]) {
+            return CXChildVisit_Continue;
+        }
+        found = query->depth + 1 == query->path.size();
+    }
+
+    // Generate the element itself, or look up the symbol in its children.
+    if (found) {
+        if (_filter->match(cursor)) {
+            ++query->found;
+            visit(cursor, parent, &query->data);
+        }
+        return CXChildVisit_Continue;
+    }
+    if (enclosing(clang_getCursorKind(cursor))) {
+        ++query->depth;
+        clang_visitChildren(cursor, querying, (CXClientData)query);
+        --query->depth;
+    }
+    return CXChildVisit_Continue;
+}
+
 } // namespace muddoc
@@ -30,15 +30,35 @@
 #include <filesystem>
 #include <memory>
 #include <iostream>
+#include <string>
+#include <vector>
 #include <clang-c/Index.h>
+#include "fingerprint.h"
+#include "symbols.h"
 
 namespace muddoc {
 
-static CXChildVisitResult __visit(CXCursor, CXCursor, CXClientData);
+/** Forward declaration */
+class ClassDescriptor;
+class Descriptor;
+class EnumDescriptor;
+class NamespaceDescriptor;
+class ParamDescriptor;
+class SearchIndex;
+class Sink;
 
 class Filter
 {
 public:
+    /**
+     * @brief The outcome of testing a cursor.
+     */
+    enum Match {
+        Skip,       /**< Skip the language construct and its children */
+        Enter,      /**< Only consider the children of the construct */
+        Accept      /**< Generate the language construct */
+    };
+
     /**
      * @brief Clone this object.
      *
@@ -61,6 +81,23 @@ public:
      */
     virtual bool match(const CXCursor& cursor) const = 0;
 
+    /**
+     * @brief Test the cursor against the filter condition.
+     *
+     * @details
+     * Unlike @c match, this can tell that a scope, like a namespace, does not
+     * match itself but that its children may, such that the scope is only
+     * entered. By default the construct is generated if it matches and
+     * skipped otherwise.
+     *
+     * @param cursor The language construct to test.
+     * @return Whether to generate, enter or skip the language construct.
+     */
+    virtual Match test(const CXCursor& cursor) const
+    {
+        return match(cursor) ? Accept : Skip;
+    }
+
 protected:
     
     Filter() = default;
@@ -138,7 +175,9 @@ private:
  * @details
  * The visitor object can generate an XML representation of a translation
  * unit by iterating over all of its elements and generating their
- * representation when each element is visited.
+ * representation when each element is visited. More generally, the
+ * descriptions of the elements are passed as events to a @c Sink, which
+ * may pass them on to several output formats at once.
  */
 class Visitor
 {
@@ -151,6 +190,39 @@ public:
      */
     Visitor(CXTranslationUnit unit);
 
+    /**
+     * @brief Set the search index to add the generated symbols to.
+     *
+     * @param index The search index, or @c nullptr to not build one.
+     */
+    void search(SearchIndex* index) { _search = index; }
+
+    /**
+     * @brief Generate only a minimal record per symbol.
+     *
+     * @details
+     * Instead of describing the declarations, only their kind, name, USR and
+     * location are output, as @c symbol elements that are nested like their
+     * declarations. The comments are neither parsed nor validated and the
+     * declarations are not pretty-printed. The same declarations are visited
+     * and filtered as when they are described.
+     *
+     * @param minimal True to only output the symbol records.
+     */
+    void minimal(bool minimal) { _minimal = minimal; }
+
+    /**
+     * @brief Only validate the comments of the declarations.
+     *
+     * @details
+     * The declarations are visited and described as usual, so that their
+     * comments are validated and the warnings reported, but nothing is
+     * output and the cross-references are not resolved.
+     *
+     * @param lint True to only validate the comments.
+     */
+    void lint(bool lint) { _lint = lint; }
+
     /**
      * @brief Generate a representation of the translation unit.
      *
@@ -161,25 +233,100 @@ public:
      *
      * @param output The output stream to push the 
      * @param filter The filter to apply.
+     * @param file The name of the documented file.
+     */
+    void generate(std::ostream& output, const Filter& filter,
+            const std::string& file);
+
+    /**
+     * @brief Generate the events of the translation unit.
+     *
+     * @details
+     * Iterate over all the elements of the translation unit that pass the
+     * filter and pass their descriptions to the @p sink, in a single walk of
+     * the translation unit. That walk is preceded by a cheap walk that only
+     * indexes the symbols, which is passed to the sink to resolve the
+     * cross-references with. The minimal symbol records are only output by
+     * the stream overload, they have no events. The sink can be a
+     * @c Listener, to use the descriptions in-process without any output.
+     *
+     * @param sink The sink to pass the events to.
+     * @param filter The filter to apply.
+     * @param file The name of the documented file.
+     */
+    void generate(Sink& sink, const Filter& filter, const std::string& file);
+
+    /**
+     * @brief Generate a representation of a single symbol.
+     *
+     * @details
+     * Look up the declarations of the symbol and only generate their XML
+     * representation, including that of their members, rather than that of
+     * the whole translation unit. The lookup only descends into the
+     * namespaces, classes and enumerations that enclose the symbol, so most
+     * of the translation unit is never visited. All the declarations that
+     * match and pass the filter are output, like the overloads of a method
+     * or a namespace that is opened more than once.
+     *
+     * The references to symbols that are not generated are left unresolved,
+     * without a warning.
+     *
+     * @param output The output stream to push the representation to.
+     * @param filter The filter to apply.
+     * @param file The name of the documented file.
+     * @param symbol The qualified name of the symbol, like "ns::Class::method",
+     * or its USR.
+     * @param usr True if @p symbol is a USR.
+     * @return The number of declarations that have been found.
+     */
+    size_t query(std::ostream& output, const Filter& filter,
+            const std::string& file, const std::string& symbol, bool usr);
+
+    /**
+     * @brief Generate the events of a single symbol.
+     *
+     * @details
+     * Like the stream overload, but the descriptions of the declarations are
+     * passed to the @p sink.
+     *
+     * @param sink The sink to pass the events to.
+     * @param filter The filter to apply.
+     * @param file The name of the documented file.
+     * @param symbol The qualified name of the symbol, or its USR.
+     * @param usr True if @p symbol is a USR.
+     * @return The number of declarations that have been found.
      */
-    void generate(std::ostream& output, const Filter& filter);
+    size_t query(Sink& sink, const Filter& filter, const std::string& file,
+            const std::string& symbol, bool usr);
 
     /**
-     * @brief Generate a representation of all the children from a particular
-     * cursor location.
+     * @brief Generate the members of a scope.
      *
      * @details
-     * Visit all the children of the cursor location and construct the
-     * XML representation.
+     * Pass the start of the scope and its comments to the sink, followed by
+     * the descriptions of all the members of the scope. The end of the scope
+     * is passed once the description of the scope is complete.
      *
-     * @param cursor The location to visit the children of.
-     * @return The XML result of the descriptions of the cursor.
+     * @param scope The scope to generate the members of.
+     * @param members The fingerprint to add the hashes of the members to,
+     * or @c nullptr.
      */
-    std::string generate(CXCursor cursor) const;
+    void generate(const NamespaceDescriptor& scope,
+            Fingerprint* members = nullptr) const;
+    void generate(const ClassDescriptor& scope,
+            Fingerprint* members = nullptr) const;
+    void generate(const EnumDescriptor& scope,
+            Fingerprint* members = nullptr) const;
 
 private:
-    friend CXChildVisitResult __visit(CXCursor, CXCursor, CXClientData);
     struct ClientData;
+    struct Query;
+
+    /* The clang visitation callbacks, that forward to visit() and query() */
+    static CXChildVisitResult visiting(CXCursor cursor, CXCursor parent,
+            CXClientData client_data);
+    static CXChildVisitResult querying(CXCursor cursor, CXCursor parent,
+            CXClientData client_data);
 
     /**
      * @brief Visitor function when iterating through the language elements.
@@ -199,6 +346,23 @@ private:
     CXChildVisitResult visit(CXCursor cursor, CXCursor parent,
             struct ClientData* data) const;
 
+    /**
+     * @brief Visitor function when looking up a symbol.
+     *
+     * @details
+     * Generate the representation of the element if it is the symbol that
+     * is looked up, or look further in its children if it encloses the
+     * symbol. Any other element is skipped without visiting its children.
+     *
+     * @param cursor The location for the language element.
+     * @param parent The location for the language element's parent.
+     * @param query The symbol being looked up.
+     * @return Always @c CXChildVisit_Continue, the enclosing elements are
+     * visited by the function itself.
+     */
+    CXChildVisitResult query(CXCursor cursor, CXCursor parent,
+            struct Query* query) const;
+
     /**
      * @brief Generate the output for the language element.
      *
@@ -247,12 +411,94 @@ private:
             const clang::TypedefDecl* decl,
             struct ClientData* data) const;
 
+    /**
+     * @brief Record a generated symbol.
+     *
+     * @details
+     * Add the symbol to the search index, if there is one. Its hash is added
+     * to the fingerprint of the enclosing scope, if that is computed.
+     *
+     * @param descriptor The descriptor of the symbol.
+     * @param kind The kind of the symbol.
+     * @param data The custom client data.
+     */
+    void record(const Descriptor& descriptor, const char* kind,
+            struct ClientData* data) const;
+
+    /**
+     * @brief Pass the comments of a declaration to the sink.
+     *
+     * @details
+     * Pass the text events of a declaration, that follow its own event: the
+     * described parameters, the description of the return value if any, and
+     * the brief and detailed text.
+     *
+     * @param descriptor The descriptor of the declaration.
+     * @param params The described parameters of the declaration.
+     * @param returns The description of the return value, or empty.
+     */
+    void comments(const Descriptor& descriptor,
+            const std::vector<ParamDescriptor>& params,
+            const std::string& returns) const;
+
+    /**
+     * @brief Look up a symbol and generate its declarations.
+     *
+     * @param data The custom client data.
+     * @param symbol The qualified name of the symbol, or its USR.
+     * @param usr True if @p symbol is a USR.
+     * @return The number of declarations that have been found.
+     */
+    size_t lookup(struct ClientData& data, const std::string& symbol,
+            bool usr) const;
+
+    /**
+     * @brief Output the start of the document of a file of symbol records.
+     *
+     * @param ostr The stream to output to.
+     * @param file The name of the documented file.
+     */
+    void document(std::ostream& ostr, const std::string& file) const;
+
+    /**
+     * @brief Output the minimal record of a symbol.
+     *
+     * @details
+     * Output the @c symbol element of the declaration and, for a declaration
+     * with @p members, the records of the members nested within. When
+     * indexing, the symbol and its members are only added to the index of
+     * the cross-references instead.
+     *
+     * @param cursor The location for the language element.
+     * @param decl The language element declaration.
+     * @param kind The kind of the symbol.
+     * @param members True to visit the members of the declaration.
+     * @param data The custom client data.
+     */
+    void symbol(const CXCursor& cursor, const clang::NamedDecl* decl,
+            const char* kind, bool members, struct ClientData* data) const;
+
     /** The translation unit to visit */
     CXTranslationUnit _unit;
 
     /** The filter to apply while generating. */
     std::shared_ptr<Filter> _filter;
 
+    /** The sink to pass the events to while generating. */
+    Sink* _sink;
+
+    /** The symbols that are generated, to resolve references. */
+    mutable SymbolIndex _symbols;
+
+    /** The search index to add the symbols to, if any. */
+    SearchIndex* _search;
+
+    /** True to only output the minimal symbol records. */
+    bool _minimal;
+
+    /** True to only validate the comments. */
+    bool _lint;
+
 };
 
 } // namespace muddoc
@@ -24,22 +24,316 @@
  * ++ end-license-description ++
  */
 
-#include <iostream>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <map>
+#include <unordered_map>
+#include <sstream>
+#include "utility.h"
 #include "warn_error.h"
 
 namespace muddoc {
 
+/* The names of the severities, in the order of Diagnostics::Severity */
+static const char* severities[] = { "note", "warning", "error" };
+
+/* The prefixes of the severities in plain text */
+static const char* prefixes[] = { "[note]: ", "[warn]: ", "[error]: " };
+
+Diagnostics::Diagnostics()
+    : _threshold(Note)
+{
+}
+
 void
-warn(const CXCursor& cursor, const std::string& msg)
+Diagnostics::add(Severity severity, const char* rule, const CXCursor& cursor,
+        const std::string& msg)
 {
+    if (!enabled(severity)) {
+        return;
+    }
+
+    // The identity includes the raw location, such that duplicates are
+    // dropped without resolving the location.
     CXSourceLocation location = clang_getCursorLocation(cursor);
-    CXString filename;
-    unsigned int line, column;
-    clang_getPresumedLocation(location, &filename, &line, &column);
-    std::cerr << "[warn]: " << clang_getCString(filename) << ":" << line << ": "
-              << msg.c_str() << std::endl;
-    clang_disposeString(filename);
+    std::string identity;
+    identity.reserve(msg.size() + ::strlen(rule) + sizeof(location) + 1);
+    identity.append(rule).append(1, '\0').append(msg);
+    identity.append(reinterpret_cast<const char*>(location.ptr_data),
+            sizeof(location.ptr_data));
+    identity.append(reinterpret_cast<const char*>(&location.int_data),
+            sizeof(location.int_data));
+    if (!_seen.insert(identity).second) {
+        return;
+    }
+    _entries.push_back({ severity, rule, msg, location, true, "", 0, 0 });
 }
 
-} /* namespace muddoc */
+void
+Diagnostics::add(Severity severity, const char* rule, const std::string& msg)
+{
+    if (!enabled(severity)) {
+        return;
+    }
+    std::string identity;
+    identity.append(rule).append(1, '\0').append(msg);
+    if (!_seen.insert(identity).second) {
+        return;
+    }
+    _entries.push_back({ severity, rule, msg, clang_getNullLocation(), false,
+            "", 0, 0 });
+}
+
+void
+Diagnostics::resolve()
+{
+    for (auto& entry: _entries) {
+        if (!entry.pending) {
+            continue;
+        }
+        CXString filename;
+        clang_getPresumedLocation(entry.location, &filename,
+                &entry.line, &entry.column);
+        entry.file = str(filename);
+        entry.pending = false;
+    }
+}
+
+void
+Diagnostics::append(const Diagnostics& other)
+{
+    _entries.insert(_entries.end(), other._entries.begin(),
+            other._entries.end());
+}
+
+/* The text of a diagnostic in a baseline, without its line number */
+static std::string
+accepted(const std::string& line)
+{
+    size_t prefix = line.find("]: ");
+    if (prefix == std::string::npos) {
+        return line;
+    }
+    prefix += 3;
+    size_t end = line.find(": ", prefix);
+    if (end == std::string::npos) {
+        return line;
+    }
+    size_t colon = line.rfind(':', end - 1);
+    if (colon == std::string::npos || colon < prefix || colon + 1 == end
+            || !std::all_of(line.begin() + colon + 1, line.begin() + end,
+                    [](char c) { return std::isdigit(c) != 0; })) {
+        return line;
+    }
+    return line.substr(0, colon) + line.substr(end);
+}
+
+size_t
+Diagnostics::accept(std::istream& baseline)
+{
+    resolve();
+
+    // Count the accepted diagnostics, a diagnostic may be accepted more
+    // than once.
+    std::unordered_map<std::string, size_t> accepts;
+    std::string line;
+    while (std::getline(baseline, line)) {
+        if (!line.empty()) {
+            ++accepts[accepted(line)];
+        }
+    }
+
+    // Drop the diagnostics in the order that they were added.
+    size_t dropped = 0;
+    auto end = std::remove_if(_entries.begin(), _entries.end(),
+            [&accepts, &dropped](const Entry& entry) {
+                std::string text = prefixes[entry.severity];
+                if (!entry.file.empty()) {
+                    text += entry.file + ": ";
+                }
+                text += entry.message + " [" + entry.rule + "]";
+                auto iter = accepts.find(text);
+                if (iter == accepts.end() || iter->second == 0) {
+                    return false;
+                }
+                --iter->second;
+                ++dropped;
+                return true;
+            });
+    _entries.erase(end, _entries.end());
+    return dropped;
+}
+
+void
+Diagnostics::write(std::ostream& ostr, Format format)
+{
+    resolve();
+
+    // Format all diagnostics first, such that they are written at once.
+    std::stringstream sstr;
+    switch (format) {
+        case Text:
+            text(sstr);
+            break;
+        case Json:
+            json(sstr);
+            break;
+        case Sarif:
+            sarif(sstr);
+            break;
+    }
+    ostr << sstr.rdbuf();
+    ostr.flush();
+}
+
+size_t
+Diagnostics::count(Severity severity) const
+{
+    size_t result = 0;
+    for (const auto& entry: _entries) {
+        if (entry.severity == severity) {
+            ++result;
+        }
+    }
+    return result;
+}
+
+bool
+Diagnostics::parse(const std::string& name, Severity& severity)
+{
+    for (int i = Note; i <= Error; ++i) {
+        if (name == severities[i]) {
+            severity = static_cast<Severity>(i);
+            return true;
+        }
+    }
+    return false;
+}
 
+bool
+Diagnostics::parse(const std::string& name, Format& format)
+{
+    if (name == "text") {
+        format = Text;
+    }
+    else
+    if (name == "json") {
+        format = Json;
+    }
+    else
+    if (name == "sarif") {
+        format = Sarif;
+    }
+    else {
+        return false;
+    }
+    return true;
+}
+
+void
+Diagnostics::text(std::ostream& ostr) const
+{
+    for (const auto& entry: _entries) {
+        ostr << prefixes[entry.severity];
+        if (!entry.file.empty()) {
+            ostr << entry.file << ":" << entry.line << ": ";
+        }
+        ostr << entry.message << " [" << entry.rule << "]\n";
+    }
+}
+
+void
+Diagnostics::json(std::ostream& ostr) const
+{
+    ostr << "[";
+    for (size_t i = 0; i < _entries.size(); ++i) {
+        const Entry& entry = _entries[i];
+        ostr << (i > 0 ? ",\n" : "\n")
+             << "{\"severity\":" << quote(severities[entry.severity])
+             << ",\"rule\":" << quote(entry.rule);
+        if (!entry.file.empty()) {
+            ostr << ",\"file\":" << quote(entry.file)
+                 << ",\"line\":" << entry.line
+                 << ",\"column\":" << entry.column;
+        }
+        ostr << ",\"message\":" << quote(entry.message) << "}";
+    }
+    ostr << "\n]\n";
+}
+
+void
+Diagnostics::sarif(std::ostream& ostr) const
+{
+    // The rules that are used, by their index in the output.
+    std::map<std::string, size_t> rules;
+    for (const auto& entry: _entries) {
+        rules.emplace(entry.rule, 0);
+    }
+    size_t index = 0;
+    for (auto& rule: rules) {
+        rule.second = index++;
+    }
+
+    ostr << "{\"version\":\"2.1.0\","
+         << "\"$schema\":\"https://json.schemastore.org/sarif-2.1.0.json\","
+         << "\"runs\":[{\"tool\":{\"driver\":{\"name\":\"muddoc\","
+         << "\"rules\":[";
+    for (const auto& rule: rules) {
+        ostr << (rule.second > 0 ? "," : "")
+             << "{\"id\":" << quote(rule.first) << "}";
+    }
+    ostr << "]}},\"results\":[";
+    for (size_t i = 0; i < _entries.size(); ++i) {
+        const Entry& entry = _entries[i];
+        ostr << (i > 0 ? ",\n" : "\n")
+             << "{\"ruleId\":" << quote(entry.rule)
+             << ",\"ruleIndex\":" << rules[entry.rule]
+             << ",\"level\":" << quote(severities[entry.severity])
+             << ",\"message\":{\"text\":" << quote(entry.message) << "}";
+        if (!entry.file.empty()) {
+            ostr << ",\"locations\":[{\"physicalLocation\":{"
+                 << "\"artifactLocation\":{\"uri\":" << quote(entry.file) << "},"
+                 << "\"region\":{\"startLine\":" << entry.line
+                 << ",\"startColumn\":" << entry.column << "}}}]";
+        }
+        ostr << "}";
+    }
+    ostr << "\n]}]}\n";
+}
+
+/* The collector of the current thread, if it is not the process collector */
+static thread_local Diagnostics* current = nullptr;
+
+Diagnostics&
+diagnostics()
+{
+    static Diagnostics instance;
+    return current != nullptr ? *current : instance;
+}
+
+void
+diagnostics(Diagnostics* collector)
+{
+    current = collector;
+}
+
+void
+warn(const char* rule, const CXCursor& cursor, const std::string& msg)
+{
+    diagnostics().add(Diagnostics::Warning, rule, cursor, msg);
+}
+
+void
+warn(const char* rule, const std::string& msg)
+{
+    diagnostics().add(Diagnostics::Warning, rule, msg);
+}
+
+bool
+warnings()
+{
+    return diagnostics().enabled(Diagnostics::Warning);
+}
+
+} /* namespace muddoc */
@@ -27,22 +27,255 @@
 #ifndef _MUDDOC_WARN_ERROR_H_
 #define _MUDDOC_WARN_ERROR_H_
 
+#include <iostream>
 #include <string>
+#include <unordered_set>
+#include <vector>
 #include <clang-c/Index.h>
 
 namespace muddoc {
 
+/**
+ * @brief Collector of diagnostic messages.
+ *
+ * @details
+ * The diagnostics are buffered while the documentation is generated and are
+ * output once at the end. Each diagnostic has a severity and a rule that
+ * identifies the kind of problem, like "missing-comment" or "param-name".
+ *
+ * Diagnostics below the severity threshold are dropped when they are added,
+ * before any other work is done. Call sites that need to format a message
+ * should check @c enabled first. A diagnostic that is identical to one that
+ * has already been added, including its location, is dropped as well. The
+ * source location of a diagnostic is only resolved to a file and line when
+ * the diagnostics are output, or when @c resolve is called explicitly.
+ *
+ * The diagnostics can be output as plain text, as JSON or as SARIF.
+ */
+class Diagnostics
+{
+public:
+    /**
+     * @brief The severity of a diagnostic, in increasing order.
+     */
+    enum Severity { Note, Warning, Error };
+
+    /**
+     * @brief The output format of the diagnostics.
+     */
+    enum Format { Text, Json, Sarif };
+
+    /**
+     * @brief Create an empty collector that accepts all severities.
+     */
+    Diagnostics();
+
+    /**
+     * @brief Set the severity threshold.
+     *
+     * @param severity The lowest severity that is collected.
+     */
+    void threshold(Severity severity) { _threshold = severity; }
+
+    /**
+     * @brief Get the severity threshold.
+     *
+     * @return The lowest severity that is collected.
+     */
+    Severity threshold() const { return _threshold; }
+
+    /**
+     * @brief Verify if diagnostics of a severity are collected.
+     *
+     * @param severity The severity to check.
+     * @return True if diagnostics of @p severity are collected.
+     */
+    bool enabled(Severity severity) const { return severity >= _threshold; }
+
+    /**
+     * @brief Add a diagnostic for a cursor location.
+     *
+     * @param severity The severity of the diagnostic.
+     * @param rule The identifier of the rule, a static string.
+     * @param cursor The location the diagnostic is about.
+     * @param msg The diagnostic message.
+     */
+    void add(Severity severity, const char* rule, const CXCursor& cursor,
+            const std::string& msg);
+
+    /**
+     * @brief Add a diagnostic that is not related to a location.
+     *
+     * @param severity The severity of the diagnostic.
+     * @param rule The identifier of the rule, a static string.
+     * @param msg The diagnostic message.
+     */
+    void add(Severity severity, const char* rule, const std::string& msg);
+
+    /**
+     * @brief Resolve the locations of the diagnostics.
+     *
+     * @details
+     * The locations refer to the translation unit, so they need to be
+     * resolved before the translation unit is disposed of. Only the
+     * diagnostics that have not been resolved before are resolved.
+     */
+    void resolve();
+
+    /**
+     * @brief Add the diagnostics of another collector.
+     *
+     * @details
+     * Append all diagnostics of @p other, which must have been resolved, in
+     * the order that they were added to it.
+     *
+     * @param other The collector to add the diagnostics of.
+     */
+    void append(const Diagnostics& other);
+
+    /**
+     * @brief Drop the diagnostics that have been accepted.
+     *
+     * @details
+     * The baseline holds the accepted diagnostics in the text format, one
+     * per line, like the output of an earlier run. A diagnostic is dropped
+     * if it matches a line of the baseline, ignoring the line number such
+     * that it still matches when the code around it changes. Each line of
+     * the baseline drops at most one diagnostic.
+     *
+     * @param baseline The stream to read the baseline from.
+     * @return The number of diagnostics that have been dropped.
+     */
+    size_t accept(std::istream& baseline);
+
+    /**
+     * @brief Output the diagnostics.
+     *
+     * @details
+     * Resolve any remaining locations and output all diagnostics, in the
+     * order that they were added, in a single write.
+     *
+     * @param ostr The stream to output the diagnostics to.
+     * @param format The output format.
+     */
+    void write(std::ostream& ostr, Format format);
+
+    /**
+     * @brief Get the number of diagnostics of a severity.
+     *
+     * @param severity The severity to count.
+     * @return The number of collected diagnostics of @p severity.
+     */
+    size_t count(Severity severity) const;
+
+    /**
+     * @brief Parse the name of a severity.
+     *
+     * @param name The name, one of "note", "warning" or "error".
+     * @param severity Set to the severity if the name is valid.
+     * @return True if the name is valid.
+     */
+    static bool parse(const std::string& name, Severity& severity);
+
+    /**
+     * @brief Parse the name of a format.
+     *
+     * @param name The name, one of "text", "json" or "sarif".
+     * @param format Set to the format if the name is valid.
+     * @return True if the name is valid.
+     */
+    static bool parse(const std::string& name, Format& format);
+
+private:
+    /* A collected diagnostic */
+    struct Entry
+    {
+        /* The severity of the diagnostic */
+        Severity severity;
+
+        /* The identifier of the rule */
+        const char* rule;
+
+        /* The diagnostic message */
+        std::string message;
+
+        /* The unresolved location, if there is any */
+        CXSourceLocation location;
+
+        /* True if the location still needs to be resolved */
+        bool pending;
+
+        /* The resolved location, the file is empty if there is none */
+        std::string file;
+        unsigned line;
+        unsigned column;
+    };
+
+    /* Output the diagnostics in the respective formats */
+    void text(std::ostream& ostr) const;
+    void json(std::ostream& ostr) const;
+    void sarif(std::ostream& ostr) const;
+
+    /* The collected diagnostics */
+    std::vector<Entry> _entries;
+
+    /* The identity of each collected diagnostic, to drop duplicates */
+    std::unordered_set<std::string> _seen;
+
+    /* The lowest severity that is collected */
+    Severity _threshold;
+};
+
+/**
+ * @brief Get the diagnostics collector.
+ *
+ * @details
+ * Each thread has its own collector, such that threads never contend when
+ * adding diagnostics. Unless another collector has been set for the thread,
+ * this is the collector of the process.
+ *
+ * @return The collector that the diagnostics of this thread are added to.
+ */
+Diagnostics& diagnostics();
+
+/**
+ * @brief Set the diagnostics collector of this thread.
+ *
+ * @param collector The collector to add the diagnostics of this thread to,
+ * or @c nullptr to use the collector of the process.
+ */
+void diagnostics(Diagnostics* collector);
+
 /**
  * @brief Generate a warning for the specified cursor location.
  *
  * @details
- * A warning is generated to std::err, including the location as defined by
- * the cursor. This includes the filename and line number.
+ * A warning is added to the diagnostics, including the location as defined
+ * by the cursor. This includes the filename and line number.
  *
+ * @param rule The identifier of the rule, a static string.
  * @param cursor The location to generate the warning for.
  * @param msg The warning message.
  */
-void warn(const CXCursor& cursor, const std::string& msg);
+void warn(const char* rule, const CXCursor& cursor, const std::string& msg);
+
+/**
+ * @brief Generate a warning that is not related to a location.
+ *
+ * @param rule The identifier of the rule, a static string.
+ * @param msg The warning message.
+ */
+void warn(const char* rule, const std::string& msg);
+
+/**
+ * @brief Verify if warnings are collected.
+ *
+ * @details
+ * Use this to avoid formatting a warning message that would be dropped.
+ *
+ * @return True if warnings are collected.
+ */
+bool warnings();
 
 } // namespace muddoc
 
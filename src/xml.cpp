@@ -0,0 +1,448 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#include <cstring>
+#include <sstream>
+#include "utility.h"
+#include "xml.h"
+
+namespace muddoc {
+
+/* ========================================================================
+ * XmlReader
+ * ======================================================================== */
+
+XmlReader::XmlReader(std::istream& istr)
+    : _buf(istr.rdbuf()), _line(1), _empty(false)
+{
+}
+
+int
+XmlReader::get()
+{
+    int ch = _buf->sbumpc();
+    if (ch == '\n') {
+        ++_line;
+    }
+    return ch;
+}
+
+int
+XmlReader::peek()
+{
+    return _buf->sgetc();
+}
+
+bool
+XmlReader::skip(const char* terminator)
+{
+    // Match the terminator, restarting whenever a character does not match.
+    // The terminators used do not have a repeating prefix.
+    size_t len = ::strlen(terminator);
+    size_t matched = 0;
+    while (matched < len) {
+        int ch = get();
+        if (ch == EOF) {
+            return false;
+        }
+        if (ch == terminator[matched]) {
+            ++matched;
+        }
+        else {
+            matched = (ch == terminator[0]) ? 1 : 0;
+        }
+    }
+    return true;
+}
+
+void
+XmlReader::whitespace()
+{
+    while (::isspace(peek())) {
+        get();
+    }
+}
+
+bool
+XmlReader::name(std::string& result)
+{
+    result.clear();
+    int ch = peek();
+    while (ch != EOF && !::isspace(ch) && ::strchr("<>/=?!\"'", ch) == nullptr)
+    {
+        result += static_cast<char>(get());
+        ch = peek();
+    }
+    return !result.empty();
+}
+
+bool
+XmlReader::characters(int terminator, std::string& result)
+{
+    result.clear();
+    int ch = peek();
+    while (ch != EOF && ch != terminator) {
+        get();
+        if (ch != '&') {
+            result += static_cast<char>(ch);
+            ch = peek();
+            continue;
+        }
+
+        // Resolve a character reference
+        std::string ref;
+        while ((ch = get()) != ';') {
+            if (ch == EOF || ref.size() > 8) {
+                return false;
+            }
+            ref += static_cast<char>(ch);
+        }
+        if (ref == "lt") {
+            result += '<';
+        }
+        else if (ref == "gt") {
+            result += '>';
+        }
+        else if (ref == "amp") {
+            result += '&';
+        }
+        else if (ref == "quot") {
+            result += '"';
+        }
+        else if (ref == "apos") {
+            result += '\'';
+        }
+        else if (ref.size() > 1 && ref[0] == '#') {
+            unsigned long code = (ref[1] == 'x')
+                ? ::strtoul(ref.c_str() + 2, nullptr, 16)
+                : ::strtoul(ref.c_str() + 1, nullptr, 10);
+            // Encode the code point as UTF-8
+            if (code < 0x80) {
+                result += static_cast<char>(code);
+            }
+            else if (code < 0x800) {
+                result += static_cast<char>(0xC0 | (code >> 6));
+                result += static_cast<char>(0x80 | (code & 0x3F));
+            }
+            else if (code < 0x10000) {
+                result += static_cast<char>(0xE0 | (code >> 12));
+                result += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                result += static_cast<char>(0x80 | (code & 0x3F));
+            }
+            else {
+                result += static_cast<char>(0xF0 | (code >> 18));
+                result += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+                result += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                result += static_cast<char>(0x80 | (code & 0x3F));
+            }
+        }
+        else {
+            return false;
+        }
+        ch = peek();
+    }
+    return true;
+}
+
+XmlReader::Event
+XmlReader::fail(const std::string& msg)
+{
+    std::stringstream sstr;
+    sstr << "line " << _line << ": " << msg;
+    _error = sstr.str();
+    return Error;
+}
+
+XmlReader::Event
+XmlReader::next()
+{
+    // The end of an empty element tag
+    if (_empty) {
+        _empty = false;
+        _attributes.clear();
+        return EndElement;
+    }
+
+    while (true) {
+        int ch = peek();
+        if (ch == EOF) {
+            return EndDocument;
+        }
+
+        // Character data
+        if (ch != '<') {
+            if (!characters('<', _text)) {
+                return fail("Invalid character reference");
+            }
+            return Text;
+        }
+        get();
+
+        ch = peek();
+        if (ch == '?') {
+            // Processing instruction or XML declaration
+            if (!skip("?>")) {
+                return fail("Unterminated processing instruction");
+            }
+            continue;
+        }
+        if (ch == '!') {
+            get();
+            if (peek() == '-') {
+                if (!skip("-->")) {
+                    return fail("Unterminated comment");
+                }
+                continue;
+            }
+            if (peek() == '[') {
+                // CDATA section
+                std::string keyword;
+                for (int i = 0; i < 7; ++i) {
+                    keyword += static_cast<char>(get());
+                }
+                if (keyword != "[CDATA[") {
+                    return fail("Invalid markup declaration");
+                }
+                _text.clear();
+                while (true) {
+                    ch = get();
+                    if (ch == EOF) {
+                        return fail("Unterminated CDATA section");
+                    }
+                    _text += static_cast<char>(ch);
+                    size_t len = _text.size();
+                    if (len >= 3 && _text.compare(len - 3, 3, "]]>") == 0) {
+                        _text.resize(len - 3);
+                        return CData;
+                    }
+                }
+            }
+            // Document type declaration
+            if (!skip(">")) {
+                return fail("Unterminated document type declaration");
+            }
+            continue;
+        }
+        if (ch == '/') {
+            // End tag
+            get();
+            if (!name(_name)) {
+                return fail("Missing element name");
+            }
+            whitespace();
+            if (get() != '>') {
+                return fail("Malformed end tag of '" + _name + "'");
+            }
+            _attributes.clear();
+            return EndElement;
+        }
+
+        // Start tag
+        if (!name(_name)) {
+            return fail("Missing element name");
+        }
+        _attributes.clear();
+        while (true) {
+            whitespace();
+            ch = peek();
+            if (ch == '>') {
+                get();
+                return StartElement;
+            }
+            if (ch == '/') {
+                get();
+                if (get() != '>') {
+                    return fail("Malformed empty tag of '" + _name + "'");
+                }
+                _empty = true;
+                return StartElement;
+            }
+            std::string attr;
+            if (!name(attr)) {
+                return fail("Malformed start tag of '" + _name + "'");
+            }
+            whitespace();
+            if (get() != '=') {
+                return fail("Missing value of attribute '" + attr + "'");
+            }
+            whitespace();
+            int quote = get();
+            if (quote != '"' && quote != '\'') {
+                return fail("Unquoted value of attribute '" + attr + "'");
+            }
+            std::string value;
+            if (!characters(quote, value) || get() != quote) {
+                return fail("Malformed value of attribute '" + attr + "'");
+            }
+            _attributes.emplace_back(attr, value);
+        }
+    }
+}
+
+const std::string*
+XmlReader::attribute(const std::string& name) const
+{
+    for (const auto& attr: _attributes) {
+        if (attr.first == name) {
+            return &attr.second;
+        }
+    }
+    return nullptr;
+}
+
+/* ========================================================================
+ * XmlNode
+ * ======================================================================== */
+
+XmlNode::XmlNode(const std::string& name, const XmlAttributes& attributes)
+    : _kind(Element), _name(name), _attributes(attributes)
+{
+}
+
+XmlNode::XmlNode(Kind kind, const std::string& text)
+    : _kind(kind), _text(text)
+{
+}
+
+std::unique_ptr<XmlNode>
+XmlNode::read(XmlReader& reader, std::string& error)
+{
+    // Keep the chain of open elements, the root being the first.
+    std::unique_ptr<XmlNode> root(
+            new XmlNode(reader.name(), reader.attributes()));
+    std::vector<XmlNode*> open = { root.get() };
+    while (!open.empty()) {
+        switch (reader.next()) {
+            case XmlReader::StartElement: {
+                auto node = new XmlNode(reader.name(), reader.attributes());
+                open.back()->_children.emplace_back(node);
+                open.push_back(node);
+                break; }
+            case XmlReader::EndElement:
+                if (reader.name() != open.back()->name()) {
+                    error = "End tag '" + reader.name() + "' does not match '"
+                          + open.back()->name() + "'";
+                    return nullptr;
+                }
+                open.pop_back();
+                break;
+            case XmlReader::Text:
+                open.back()->_children.emplace_back(
+                        new XmlNode(Text, reader.text()));
+                break;
+            case XmlReader::CData:
+                open.back()->_children.emplace_back(
+                        new XmlNode(CData, reader.text()));
+                break;
+            case XmlReader::EndDocument:
+                error = "Unexpected end of document in '"
+                      + open.back()->name() + "'";
+                return nullptr;
+            case XmlReader::Error:
+                error = reader.error();
+                return nullptr;
+        }
+    }
+    return root;
+}
+
+const std::string*
+XmlNode::attribute(const std::string& name) const
+{
+    for (const auto& attr: _attributes) {
+        if (attr.first == name) {
+            return &attr.second;
+        }
+    }
+    return nullptr;
+}
+
+void
+XmlNode::attribute(const std::string& name, const std::string& value)
+{
+    for (auto& attr: _attributes) {
+        if (attr.first == name) {
+            attr.second = value;
+            return;
+        }
+    }
+    _attributes.emplace_back(name, value);
+}
+
+XmlNode*
+XmlNode::child(const std::string& name) const
+{
+    for (const auto& child: _children) {
+        if (child->_kind == Element && child->_name == name) {
+            return child.get();
+        }
+    }
+    return nullptr;
+}
+
+std::string
+XmlNode::content() const
+{
+    if (_kind != Element) {
+        return _text;
+    }
+    std::string result;
+    for (const auto& child: _children) {
+        result += child->content();
+    }
+    return result;
+}
+
+std::ostream&
+operator<<(std::ostream& ostr, const XmlNode& obj)
+{
+    switch (obj.kind()) {
+        case XmlNode::Text:
+            ostr << escape(obj.text());
+            return ostr;
+        case XmlNode::CData:
+            ostr << "<![CDATA[" << obj.text() << "]]>";
+            return ostr;
+        default:
+            break;
+    }
+    ostr << "<" << obj.name();
+    for (const auto& attr: obj.attributes()) {
+        ostr << " " << attr.first << "=\"" << escape(attr.second) << "\"";
+    }
+    if (obj.children().empty()) {
+        ostr << "/>";
+        return ostr;
+    }
+    ostr << ">";
+    for (const auto& child: obj.children()) {
+        ostr << *child;
+    }
+    ostr << "</" << obj.name() << ">";
+    return ostr;
+}
+
+} // namespace muddoc
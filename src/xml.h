@@ -0,0 +1,315 @@
+/*
+ * ++ start-license-description ++
+ *
+ * Copyright (c) 2026 Stefan Sinnige.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ++ end-license-description ++
+ */
+
+#ifndef _MUDDOC_XML_H_
+#define _MUDDOC_XML_H_
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace muddoc {
+
+/** The attributes of an element, in order of appearance. */
+typedef std::vector<std::pair<std::string, std::string>> XmlAttributes;
+
+/**
+ * @brief Streaming reader of XML documents.
+ *
+ * @details
+ * A pull parser that reads an XML document from a stream one construct at a
+ * time. It supports the subset of XML that is produced by muddoc: elements,
+ * attributes, character data, CDATA sections and the predefined and numeric
+ * character references. Processing instructions, comments and document type
+ * declarations are skipped.
+ *
+ * The document is never held in memory as a whole, which allows very large
+ * documents to be processed in a single pass.
+ */
+class XmlReader
+{
+public:
+    /**
+     * @brief The constructs reported by the reader.
+     */
+    enum Event
+    {
+        StartElement,   /**< The start of an element. */
+        EndElement,     /**< The end of an element. */
+        Text,           /**< Character data. */
+        CData,          /**< A CDATA section. */
+        EndDocument,    /**< The end of the document has been reached. */
+        Error           /**< The document is malformed. */
+    };
+
+    /**
+     * @brief Create a reader for an XML document.
+     *
+     * @param istr The stream to read the document from.
+     */
+    XmlReader(std::istream& istr);
+
+    /**
+     * @brief Read the next construct.
+     *
+     * @details
+     * An empty element tag is reported as a @c StartElement immediately
+     * followed by an @c EndElement.
+     *
+     * @return The construct that has been read.
+     */
+    Event next();
+
+    /**
+     * @brief Return the name of the element.
+     * @return The element name of the last start or end element.
+     */
+    const std::string& name() const { return _name; }
+
+    /**
+     * @brief Return the attributes of the element.
+     * @return The attributes of the last start element.
+     */
+    const XmlAttributes& attributes() const { return _attributes; }
+
+    /**
+     * @brief Return the value of an attribute of the element.
+     *
+     * @param name The name of the attribute.
+     * @return The value of the attribute, or @c nullptr if the last start
+     * element does not have the attribute.
+     */
+    const std::string* attribute(const std::string& name) const;
+
+    /**
+     * @brief Return the character data.
+     * @return The unescaped character data of the last text or CDATA section.
+     */
+    const std::string& text() const { return _text; }
+
+    /**
+     * @brief Return the reason why the document is malformed.
+     * @return The error message, including the line number.
+     */
+    const std::string& error() const { return _error; }
+
+private:
+    /* Read the next character, or EOF */
+    int get();
+
+    /* Peek at the next character, or EOF */
+    int peek();
+
+    /* Skip the characters up to and including the terminator */
+    bool skip(const char* terminator);
+
+    /* Skip any whitespace */
+    void whitespace();
+
+    /* Read a name */
+    bool name(std::string& result);
+
+    /* Read character data up to the terminator, resolving references */
+    bool characters(int terminator, std::string& result);
+
+    /* Report an error */
+    Event fail(const std::string& msg);
+
+    /* The input stream buffer */
+    std::streambuf* _buf;
+
+    /* The current line number */
+    unsigned _line;
+
+    /* The name of the last element */
+    std::string _name;
+
+    /* The attributes of the last start element */
+    XmlAttributes _attributes;
+
+    /* The last character data */
+    std::string _text;
+
+    /* The error message */
+    std::string _error;
+
+    /* True if the last start element was an empty element tag */
+    bool _empty;
+};
+
+/**
+ * @brief A node in an XML document tree.
+ *
+ * @details
+ * A node is either an element with attributes and child nodes, a text node or
+ * a CDATA section. The text of text and CDATA nodes is kept unescaped and will
+ * be escaped again when the node is written.
+ */
+class XmlNode
+{
+public:
+    /**
+     * @brief The kind of node.
+     */
+    enum Kind
+    {
+        Element,    /**< An element. */
+        Text,       /**< Character data. */
+        CData       /**< A CDATA section. */
+    };
+
+    /**
+     * @brief Create an element node.
+     *
+     * @param name The element name.
+     * @param attributes The element attributes.
+     */
+    XmlNode(const std::string& name, const XmlAttributes& attributes);
+
+    /**
+     * @brief Create a text or CDATA node.
+     *
+     * @param kind The kind of node, either @c Text or @c CData.
+     * @param text The unescaped text.
+     */
+    XmlNode(Kind kind, const std::string& text);
+
+    /**
+     * @brief Read an element and all its children.
+     *
+     * @details
+     * Read the element that the @p reader has just reported the start of,
+     * up to and including its end.
+     *
+     * @param reader The reader positioned at a start element.
+     * @param error Set to the error message if the document is malformed.
+     * @return The element, or @c nullptr if the document is malformed.
+     */
+    static std::unique_ptr<XmlNode> read(XmlReader& reader, std::string& error);
+
+    /**
+     * @brief Return the kind of node.
+     * @return The kind of node.
+     */
+    Kind kind() const { return _kind; }
+
+    /**
+     * @brief Return the element name.
+     * @return The element name, or an empty string for text nodes.
+     */
+    const std::string& name() const { return _name; }
+
+    /**
+     * @brief Return the text.
+     * @return The unescaped text of a text or CDATA node.
+     */
+    const std::string& text() const { return _text; }
+
+    /**
+     * @brief Return the attributes.
+     * @return The attributes of the element.
+     */
+    const XmlAttributes& attributes() const { return _attributes; }
+
+    /**
+     * @brief Return the value of an attribute.
+     *
+     * @param name The name of the attribute.
+     * @return The value of the attribute, or @c nullptr if the element does
+     * not have the attribute.
+     */
+    const std::string* attribute(const std::string& name) const;
+
+    /**
+     * @brief Set the value of an attribute.
+     *
+     * @details
+     * Replace the value of an existing attribute, or add the attribute after
+     * the existing ones.
+     *
+     * @param name The name of the attribute.
+     * @param value The value of the attribute.
+     */
+    void attribute(const std::string& name, const std::string& value);
+
+    /**
+     * @brief Return the first child element with a name.
+     *
+     * @param name The element name.
+     * @return The child element, or @c nullptr if there is none.
+     */
+    XmlNode* child(const std::string& name) const;
+
+    /**
+     * @brief Return the text content.
+     * @return The concatenated text of all descendant text and CDATA nodes.
+     */
+    std::string content() const;
+
+    /**
+     * @brief Return the child nodes.
+     * @return The child nodes in document order.
+     */
+    std::vector<std::unique_ptr<XmlNode>>& children() { return _children; }
+    const std::vector<std::unique_ptr<XmlNode>>& children() const {
+        return _children;
+    }
+
+private:
+    /* The kind of node */
+    Kind _kind;
+
+    /* The element name */
+    std::string _name;
+
+    /* The element attributes */
+    XmlAttributes _attributes;
+
+    /* The text of a text or CDATA node */
+    std::string _text;
+
+    /* The child nodes */
+    std::vector<std::unique_ptr<XmlNode>> _children;
+};
+
+/**
+ * @brief Output a node in XML.
+ *
+ * @details
+ * Output the node and all its children. Text and attribute values are
+ * escaped, CDATA sections are written as is.
+ *
+ * @param ostr The stream to output the node to.
+ * @param obj The node to output.
+ * @return The @p ostr stream.
+ */
+std::ostream& operator<<(std::ostream& ostr, const XmlNode& obj);
+
+} // namespace muddoc
+
+#endif /* _MUDDOC_XML_H_ */